@@ -0,0 +1,184 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXBENCHMARK_H
+#define GXBENCHMARK_H
+
+#include <string>
+#include <stddef.h>
+
+/**
+ * Helpers shared by the benchmarks.
+ *
+ * Results are printed one line per measurement as comma separated values:
+ * benchmark,case,count,seconds,rate,unit
+ */
+class CGXBenchmark
+{
+public:
+    /**
+     * @return Monotonic time in seconds.
+     */
+    static double Now();
+
+    /**
+     * Print the header line of the results.
+     */
+    static void PrintHeader();
+
+    /**
+     * Print one result line.
+     *
+     * @param benchmark Name of the benchmark.
+     * @param name Name of the measured case.
+     * @param count Amount of handled items.
+     * @param seconds Elapsed time in seconds.
+     * @param unit Unit of the rate.
+     * @param scale Rate is divided with this. 1e9 gives GB/s from bytes.
+     */
+    static void Report(
+        const char* benchmark,
+        const std::string& name,
+        unsigned long long count,
+        double seconds,
+        const char* unit,
+        double scale = 1);
+
+    /**
+     * Print one result line where the rate is a measured value.
+     *
+     * @param benchmark Name of the benchmark.
+     * @param name Name of the measured case.
+     * @param count Amount of handled items.
+     * @param seconds Elapsed time in seconds.
+     * @param value Measured value.
+     * @param unit Unit of the value.
+     */
+    static void ReportValue(
+        const char* benchmark,
+        const std::string& name,
+        unsigned long long count,
+        double seconds,
+        double value,
+        const char* unit);
+
+    /**
+     * Start counting heap allocations.
+     *
+     * @param size Allocations of this size are also counted separately.
+     */
+    static void StartCounting(size_t size = 0);
+
+    /**
+     * Stop counting heap allocations.
+     */
+    static void StopCounting();
+
+    /**
+     * @return Amount of heap allocations since StartCounting.
+     */
+    static unsigned long GetAllocations();
+
+    /**
+     * @return Amount of heap allocations of the given size since StartCounting.
+     */
+    static unsigned long GetSizedAllocations();
+
+    /**
+     * @return Bytes allocated from the heap, or zero if it's not known.
+     */
+    static size_t GetHeapUsage();
+};
+
+/**
+ * Encrypt APDUs for several system titles and decode them with
+ * CGXDLMSBatchDecoder using 1..N threads.
+ */
+int BatchDecoderBenchmark(int argc, char* argv[]);
+
+/**
+ * Parse certificates, verify signatures and generate ECDH secrets
+ * with and without CGXCertificateCache.
+ */
+int CertificateCacheBenchmark(int argc, char* argv[]);
+
+/**
+ * Modular multiplication and inversion with CGXBigInteger and with
+ * the fixed width Montgomery and Barrett arithmetic, and ECDSA sign
+ * and verify.
+ */
+int BigIntegerBenchmark(int argc, char* argv[]);
+
+/**
+ * SHA-256, SHA-384, SHA-1 and MD5 throughput with and without
+ * SHA extensions, and multi-buffer SHA-256.
+ */
+int HashBenchmark(int argc, char* argv[]);
+
+/**
+ * Read request with many variables from a short name server
+ * with thousands of objects.
+ */
+int ShortNameBenchmark(int argc, char* argv[]);
+
+/**
+ * Heap allocations of a logical name server when get request
+ * with list is handled.
+ */
+int AllocationBenchmark(int argc, char* argv[]);
+
+/**
+ * Read profile generic with mixed column types in blocks.
+ */
+int ProfileBenchmark(int argc, char* argv[]);
+
+/**
+ * Parse HDLC frames from streams with noise between the frames.
+ */
+int HdlcBenchmark(int argc, char* argv[]);
+
+/**
+ * Generate frames of large set requests and image blocks with
+ * copied frames and with the frame writer.
+ */
+int FrameWriterBenchmark(int argc, char* argv[]);
+
+/**
+ * Read large compact data buffer and association object list in blocks
+ * when the value is serialized at once and when it's produced per block.
+ */
+int LongReadBenchmark(int argc, char* argv[]);
+
+#endif //GXBENCHMARK_H
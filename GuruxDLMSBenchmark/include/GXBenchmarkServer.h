@@ -0,0 +1,136 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXBENCHMARKSERVER_H
+#define GXBENCHMARKSERVER_H
+
+#include "../../development/include/GXDLMSServer.h"
+#include "../../development/include/GXDLMSClient.h"
+
+/**
+ * In-process server. All reads and writes are accepted and
+ * values are read from the objects.
+ *
+ * Requests of the client are passed to the server with function calls
+ * so only the DLMS handling is measured.
+ */
+class CGXBenchmarkServer : public CGXDLMSServer
+{
+private:
+    /**
+     * Amount of replies that Exchange has received.
+     */
+    unsigned long m_Replies;
+
+    /**
+     * Size of the replies that Exchange has received in bytes.
+     */
+    unsigned long long m_ReplyBytes;
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param logicalNameReferencing
+     *            Is logical name referencing used.
+     * @param type
+     *            Interface type.
+     */
+    CGXBenchmarkServer(
+        bool logicalNameReferencing,
+        DLMS_INTERFACE_TYPE type);
+
+    /**
+     * Send messages to the server and parse the reply.
+     * Receiver ready messages are sent until all data is received.
+     *
+     * @param client
+     *            Client.
+     * @param messages
+     *            Generated messages.
+     * @param reply
+     *            Received data.
+     */
+    int Exchange(
+        CGXDLMSClient& client,
+        std::vector<CGXByteBuffer>& messages,
+        CGXReplyData& reply);
+
+    /**
+     * @return Amount of replies that Exchange has received.
+     */
+    unsigned long GetReplies();
+
+    /**
+     * @return Size of the replies that Exchange has received in bytes.
+     */
+    unsigned long long GetReplyBytes();
+
+    /**
+     * Reset reply counters.
+     */
+    void ResetReplies();
+
+    /**
+     * Open association.
+     */
+    int Connect(CGXDLMSClient& client);
+
+    bool IsTarget(
+        unsigned long int serverAddress,
+        unsigned long clientAddress);
+    DLMS_SOURCE_DIAGNOSTIC ValidateAuthentication(
+        DLMS_AUTHENTICATION authentication,
+        CGXByteBuffer& password);
+    CGXDLMSObject* FindObject(
+        DLMS_OBJECT_TYPE objectType,
+        int sn,
+        std::string& ln);
+    void PreRead(std::vector<CGXDLMSValueEventArg*>& args);
+    void PreWrite(std::vector<CGXDLMSValueEventArg*>& args);
+    void Connected(CGXDLMSConnectionEventArgs& connectionInfo);
+    void InvalidConnection(CGXDLMSConnectionEventArgs& connectionInfo);
+    void Disconnected(CGXDLMSConnectionEventArgs& connectionInfo);
+    DLMS_ACCESS_MODE GetAttributeAccess(CGXDLMSValueEventArg* arg);
+    DLMS_METHOD_ACCESS_MODE GetMethodAccess(CGXDLMSValueEventArg* arg);
+    void PreAction(std::vector<CGXDLMSValueEventArg*>& args);
+    void PostRead(std::vector<CGXDLMSValueEventArg*>& args);
+    void PostWrite(std::vector<CGXDLMSValueEventArg*>& args);
+    void PostAction(std::vector<CGXDLMSValueEventArg*>& args);
+    void PreGet(std::vector<CGXDLMSValueEventArg*>& args);
+    void PostGet(std::vector<CGXDLMSValueEventArg*>& args);
+};
+
+#endif //GXBENCHMARKSERVER_H
@@ -0,0 +1,154 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../include/GXBenchmarkServer.h"
+#include "../../development/include/GXDLMSData.h"
+#include "../../development/include/GXHelpers.h"
+
+/**
+ * Read the given amount of variables with one get request
+ * and count heap allocations of the server.
+ */
+static int ReadVariables(int variables, int count)
+{
+    int ret, pos;
+    char name[64];
+    CGXBenchmarkServer server(true, DLMS_INTERFACE_TYPE_WRAPPER);
+    for (pos = 0; pos != variables; ++pos)
+    {
+        char ln[32];
+        snprintf(ln, sizeof(ln), "0.0.96.%d.%d.255", pos / 256, pos % 256);
+        CGXDLMSData* data = new CGXDLMSData(ln);
+        CGXDLMSVariant value((unsigned long)pos);
+        data->SetValue(value);
+        server.GetItems().push_back(data);
+    }
+    if ((ret = server.Initialize()) != 0)
+    {
+        return ret;
+    }
+    CGXDLMSClient client(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, DLMS_INTERFACE_TYPE_WRAPPER);
+    if ((ret = server.Connect(client)) != 0)
+    {
+        return ret;
+    }
+    //Client splits the list to ten items. Get request with list is made here
+    //so all variables are read with one request.
+    CGXByteBuffer pdu;
+    pdu.SetUInt8(DLMS_COMMAND_GET_REQUEST);
+    pdu.SetUInt8(DLMS_GET_COMMAND_TYPE_WITH_LIST);
+    pdu.SetUInt8(0xC1);
+    GXHelpers::SetObjectCount(variables, pdu);
+    for (pos = 0; pos != variables; ++pos)
+    {
+        pdu.SetUInt16(DLMS_OBJECT_TYPE_DATA);
+        unsigned char ln[6];
+        GXHelpers::SetLogicalName(server.GetItems()[pos]->GetName().ToString().c_str(), ln);
+        pdu.Set(ln, 6);
+        pdu.SetUInt8(2);
+        pdu.SetUInt8(0);
+    }
+    //Wrapper header.
+    CGXByteBuffer request;
+    request.SetUInt16(1);
+    request.SetUInt16(16);
+    request.SetUInt16(1);
+    request.SetUInt16((unsigned short)pdu.GetSize());
+    request.Set(&pdu);
+    std::vector<CGXByteBuffer> messages;
+    messages.push_back(request);
+    CGXReplyData reply;
+    if ((ret = server.Exchange(client, messages, reply)) != 0)
+    {
+        return ret;
+    }
+    if (reply.GetValue().Arr.size() != (size_t)variables ||
+        reply.GetValue().Arr[variables - 1].ToInteger() != variables - 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_RESPONSE;
+    }
+    CGXByteBuffer data;
+    //Reply buffer is allocated before the measurement.
+    data.Capacity(0x10000);
+    double start = CGXBenchmark::Now();
+    CGXBenchmark::StartCounting(sizeof(CGXDLMSValueEventArg));
+    for (pos = 0; pos != count; ++pos)
+    {
+        for (std::vector<CGXByteBuffer>::iterator it = messages.begin(); it != messages.end(); ++it)
+        {
+            data.SetSize(0);
+            if ((ret = server.HandleRequest(*it, data)) != 0)
+            {
+                CGXBenchmark::StopCounting();
+                return ret;
+            }
+        }
+    }
+    CGXBenchmark::StopCounting();
+    double elapsed = CGXBenchmark::Now() - start;
+    snprintf(name, sizeof(name), "variables=%d", variables);
+    CGXBenchmark::Report("allocations", name, count, elapsed, "requests/s");
+    snprintf(name, sizeof(name), "variables=%d/new", variables);
+    CGXBenchmark::ReportValue("allocations", name, count, elapsed,
+        (double)CGXBenchmark::GetAllocations() / count, "allocations/request");
+    snprintf(name, sizeof(name), "variables=%d/arguments", variables);
+    CGXBenchmark::ReportValue("allocations", name, count, elapsed,
+        (double)CGXBenchmark::GetSizedAllocations() / count, "allocations/request");
+    return 0;
+}
+
+int AllocationBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int variables = argc > 0 ? atoi(argv[0]) : 0;
+    int count = argc > 1 ? atoi(argv[1]) : 20000;
+    if (variables < 0 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if (variables != 0)
+    {
+        return ReadVariables(variables, count);
+    }
+    if ((ret = ReadVariables(10, count)) != 0 ||
+        (ret = ReadVariables(100, count)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
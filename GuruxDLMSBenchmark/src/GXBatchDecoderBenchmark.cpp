@@ -0,0 +1,176 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#if defined(_WIN32) || defined(_WIN64)//Windows includes
+#include <windows.h>
+#else //Linux includes.
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXDLMSBatchDecoder.h"
+#include "../../development/include/GXCipher.h"
+#include "../../development/include/GXDateTime.h"
+#include "../../development/include/GXHelpers.h"
+
+/**
+* Returns amount of available processors.
+*/
+static int GetProcessorCount()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (int)count;
+#endif
+}
+
+/**
+* Generate get response that returns a structure of
+* register value, capture time and status.
+*/
+static int GetResponse(CGXDLMSSettings& settings, int index, CGXByteBuffer& pdu)
+{
+    int ret;
+    CGXDateTime dt(2020, 1, 1 + index % 28, index % 24, index % 60, 0, 0, 0);
+    CGXDLMSVariant tmp(dt);
+    pdu.Clear();
+    if ((ret = pdu.SetUInt8(DLMS_COMMAND_GET_RESPONSE)) != 0 ||
+        (ret = pdu.SetUInt8(1)) != 0 ||
+        (ret = pdu.SetUInt8(0xC1)) != 0 ||
+        (ret = pdu.SetUInt8(0)) != 0 ||
+        (ret = pdu.SetUInt8(DLMS_DATA_TYPE_STRUCTURE)) != 0 ||
+        (ret = pdu.SetUInt8(3)) != 0 ||
+        (ret = pdu.SetUInt8(DLMS_DATA_TYPE_UINT32)) != 0 ||
+        (ret = pdu.SetUInt32(index)) != 0 ||
+        (ret = GXHelpers::SetData(&settings, pdu, DLMS_DATA_TYPE_OCTET_STRING, tmp)) != 0 ||
+        (ret = pdu.SetUInt8(DLMS_DATA_TYPE_UINT8)) != 0 ||
+        (ret = pdu.SetUInt8(index & 0xFF)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
+
+int BatchDecoderBenchmark(int argc, char* argv[])
+{
+    int ret, pos, threads;
+    int count = argc > 0 ? atoi(argv[0]) : 20000;
+    int titles = argc > 1 ? atoi(argv[1]) : 8;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : GetProcessorCount();
+    if (count < 1 || titles < 1 || titles > 255 || maxThreads < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXDLMSBatchDecoder decoder;
+    CGXDLMSSettings settings(true);
+    std::vector<CGXCipher*> ciphers;
+    CGXByteBuffer empty, pdu;
+    //Each meter has own system title and keys.
+    for (pos = 0; pos != titles; ++pos)
+    {
+        CGXByteBuffer st, bck, ak;
+        st.SetHexString2("4D4D4D0000BC6100");
+        st.SetUInt8(7, (unsigned char)pos);
+        bck.SetHexString2("000102030405060708090A0B0C0D0E0F");
+        bck.SetUInt8(15, (unsigned char)pos);
+        ak.SetHexString2("D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF");
+        CGXCipher* cipher = new CGXCipher(st);
+        cipher->SetBlockCipherKey(bck);
+        cipher->SetAuthenticationKey(ak);
+        ciphers.push_back(cipher);
+        if ((ret = decoder.AddKeys(st, bck, ak, empty)) != 0)
+        {
+            break;
+        }
+    }
+    std::vector<CGXDLMSBatchItem> items;
+    items.reserve(count);
+    for (pos = 0; ret == 0 && pos != count; ++pos)
+    {
+        CGXCipher* cipher = ciphers[pos % titles];
+        if ((ret = GetResponse(settings, pos, pdu)) != 0)
+        {
+            break;
+        }
+        //Reserve space for the header and authentication tag.
+        pdu.Capacity(pdu.GetSize() + 32);
+        if ((ret = cipher->Encrypt(DLMS_SECURITY_SUITE_V0,
+            DLMS_SECURITY_AUTHENTICATION_ENCRYPTION, DLMS_COUNT_TYPE_PACKET,
+            pos, DLMS_COMMAND_GLO_GET_RESPONSE, cipher->GetSystemTitle(),
+            cipher->GetBlockCipherKey(), pdu, true)) != 0)
+        {
+            break;
+        }
+        items.push_back(CGXDLMSBatchItem(cipher->GetSystemTitle(), pdu));
+    }
+    for (std::vector<CGXCipher*>::iterator it = ciphers.begin(); it != ciphers.end(); ++it)
+    {
+        delete *it;
+    }
+    if (ret != 0)
+    {
+        return ret;
+    }
+    char name[32];
+    for (threads = 1; ; threads = threads * 2 > maxThreads && threads != maxThreads ? maxThreads : threads * 2)
+    {
+        decoder.SetThreadCount(threads);
+        double start = CGXBenchmark::Now();
+        if ((ret = decoder.Decode(items)) != 0)
+        {
+            return ret;
+        }
+        double elapsed = CGXBenchmark::Now() - start;
+        for (std::vector<CGXDLMSBatchItem>::iterator it = items.begin(); it != items.end(); ++it)
+        {
+            if (it->GetError() != 0)
+            {
+                return it->GetError();
+            }
+        }
+        snprintf(name, sizeof(name), "titles=%d/threads=%d", titles, threads);
+        CGXBenchmark::Report("batch", name, (unsigned long long)count, elapsed, "apdu/s");
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#if defined(_WIN32) || defined(_WIN64)//Windows includes
+#include <windows.h>
+#else //Linux includes.
+#include <time.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include "../include/GXBenchmark.h"
+
+/**
+ * Are allocations counted. Counting is enabled only while
+ * single threaded code is measured.
+ */
+static bool COUNTING = false;
+
+/**
+ * Amount of heap allocations.
+ */
+static unsigned long ALLOCATIONS = 0;
+
+/**
+ * Size of the allocations that are counted separately.
+ */
+static size_t SIZE = 0;
+
+/**
+ * Amount of heap allocations that have the given size.
+ */
+static unsigned long SIZED = 0;
+
+void* operator new(size_t size)
+{
+    if (COUNTING)
+    {
+        ++ALLOCATIONS;
+        if (size == SIZE)
+        {
+            ++SIZED;
+        }
+    }
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+void CGXBenchmark::StartCounting(size_t size)
+{
+    ALLOCATIONS = SIZED = 0;
+    SIZE = size;
+    COUNTING = true;
+}
+
+void CGXBenchmark::StopCounting()
+{
+    COUNTING = false;
+}
+
+unsigned long CGXBenchmark::GetAllocations()
+{
+    return ALLOCATIONS;
+}
+
+unsigned long CGXBenchmark::GetSizedAllocations()
+{
+    return SIZED;
+}
+
+double CGXBenchmark::Now()
+{
+#if defined(_WIN32) || defined(_WIN64)//Windows
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else //Linux
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+#endif
+}
+
+void CGXBenchmark::PrintHeader()
+{
+    printf("benchmark,case,count,seconds,rate,unit\n");
+}
+
+void CGXBenchmark::Report(
+    const char* benchmark,
+    const std::string& name,
+    unsigned long long count,
+    double seconds,
+    const char* unit,
+    double scale)
+{
+    double rate = seconds > 0 ? count / seconds / scale : 0;
+    printf("%s,%s,%llu,%.6f,%.3f,%s\n", benchmark, name.c_str(), count, seconds, rate, unit);
+    fflush(stdout);
+}
+
+void CGXBenchmark::ReportValue(
+    const char* benchmark,
+    const std::string& name,
+    unsigned long long count,
+    double seconds,
+    double value,
+    const char* unit)
+{
+    printf("%s,%s,%llu,%.6f,%.3f,%s\n", benchmark, name.c_str(), count, seconds, value, unit);
+    fflush(stdout);
+}
+
+size_t CGXBenchmark::GetHeapUsage()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
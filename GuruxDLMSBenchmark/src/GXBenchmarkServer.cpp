@@ -0,0 +1,208 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include "../include/GXBenchmarkServer.h"
+
+CGXBenchmarkServer::CGXBenchmarkServer(
+    bool logicalNameReferencing,
+    DLMS_INTERFACE_TYPE type) : CGXDLMSServer(logicalNameReferencing, type)
+{
+    m_Replies = 0;
+    m_ReplyBytes = 0;
+}
+
+unsigned long CGXBenchmarkServer::GetReplies()
+{
+    return m_Replies;
+}
+
+unsigned long long CGXBenchmarkServer::GetReplyBytes()
+{
+    return m_ReplyBytes;
+}
+
+void CGXBenchmarkServer::ResetReplies()
+{
+    m_Replies = 0;
+    m_ReplyBytes = 0;
+}
+
+int CGXBenchmarkServer::Exchange(
+    CGXDLMSClient& client,
+    std::vector<CGXByteBuffer>& messages,
+    CGXReplyData& reply)
+{
+    int ret;
+    CGXByteBuffer data, rr;
+    for (std::vector<CGXByteBuffer>::iterator it = messages.begin(); it != messages.end(); ++it)
+    {
+        reply.Clear();
+        CGXByteBuffer* request = &(*it);
+        do
+        {
+            data.Clear();
+            if ((ret = HandleRequest(*request, data)) != 0)
+            {
+                return ret;
+            }
+            ++m_Replies;
+            m_ReplyBytes += data.GetSize();
+            if ((ret = client.GetData(data, reply)) != 0)
+            {
+                return ret;
+            }
+            if (!reply.IsComplete())
+            {
+                return DLMS_ERROR_CODE_INVALID_RESPONSE;
+            }
+            if (!reply.IsMoreData())
+            {
+                break;
+            }
+            rr.Clear();
+            if ((ret = client.ReceiverReady(reply.GetMoreData(), rr)) != 0)
+            {
+                return ret;
+            }
+            request = &rr;
+        } while (true);
+    }
+    return 0;
+}
+
+int CGXBenchmarkServer::Connect(CGXDLMSClient& client)
+{
+    int ret;
+    CGXReplyData reply;
+    std::vector<CGXByteBuffer> messages;
+    CGXByteBuffer data;
+    if ((ret = client.SNRMRequest(messages)) != 0)
+    {
+        return ret;
+    }
+    if (!messages.empty())
+    {
+        if ((ret = Exchange(client, messages, reply)) != 0 ||
+            (ret = client.ParseUAResponse(reply.GetData())) != 0)
+        {
+            return ret;
+        }
+    }
+    messages.clear();
+    reply.Clear();
+    if ((ret = client.AARQRequest(messages)) != 0 ||
+        (ret = Exchange(client, messages, reply)) != 0 ||
+        (ret = client.ParseAAREResponse(reply.GetData())) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
+
+bool CGXBenchmarkServer::IsTarget(
+    unsigned long int serverAddress,
+    unsigned long clientAddress)
+{
+    return true;
+}
+
+DLMS_SOURCE_DIAGNOSTIC CGXBenchmarkServer::ValidateAuthentication(
+    DLMS_AUTHENTICATION authentication,
+    CGXByteBuffer& password)
+{
+    return DLMS_SOURCE_DIAGNOSTIC_NONE;
+}
+
+CGXDLMSObject* CGXBenchmarkServer::FindObject(
+    DLMS_OBJECT_TYPE objectType,
+    int sn,
+    std::string& ln)
+{
+    return NULL;
+}
+
+void CGXBenchmarkServer::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PreWrite(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::Connected(CGXDLMSConnectionEventArgs& connectionInfo)
+{
+}
+
+void CGXBenchmarkServer::InvalidConnection(CGXDLMSConnectionEventArgs& connectionInfo)
+{
+}
+
+void CGXBenchmarkServer::Disconnected(CGXDLMSConnectionEventArgs& connectionInfo)
+{
+}
+
+DLMS_ACCESS_MODE CGXBenchmarkServer::GetAttributeAccess(CGXDLMSValueEventArg* arg)
+{
+    return DLMS_ACCESS_MODE_READ_WRITE;
+}
+
+DLMS_METHOD_ACCESS_MODE CGXBenchmarkServer::GetMethodAccess(CGXDLMSValueEventArg* arg)
+{
+    return DLMS_METHOD_ACCESS_MODE_ACCESS;
+}
+
+void CGXBenchmarkServer::PreAction(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PostRead(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PostWrite(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PostAction(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PreGet(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
+
+void CGXBenchmarkServer::PostGet(std::vector<CGXDLMSValueEventArg*>& args)
+{
+}
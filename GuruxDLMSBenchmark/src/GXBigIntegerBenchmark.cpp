@@ -0,0 +1,206 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXFixedCurve.h"
+#include "../../development/include/GXEcdsa.h"
+
+/**
+ * Results are written here so the compiler can't drop the measured loops.
+ */
+static volatile unsigned char RESULT;
+
+template <uint16_t BITS>
+static void Consume(const CGXFixedInteger<BITS>& value)
+{
+    unsigned char tmp[BITS / 8];
+    value.ToBytes(tmp);
+    RESULT ^= tmp[BITS / 8 - 1];
+}
+
+/**
+ * Compare modular multiplication and inversion of CGXBigInteger
+ * with the fixed width Montgomery and Barrett arithmetic.
+ */
+template <uint16_t BITS>
+static int FieldBenchmark(ECC scheme, const char* curveName, int count)
+{
+    int ret, pos;
+    double start;
+    char name[64];
+    CGXCurve curve;
+    if ((ret = curve.Init(scheme)) != 0)
+    {
+        return ret;
+    }
+    CGXFixedInteger<BITS> p, a, b, r;
+    CGXMontgomery<BITS> montgomery;
+    CGXBarrett<BITS> barrett;
+    //Use coordinates of the base point as test values.
+    if ((ret = p.FromBigInteger(curve.GetP())) != 0 ||
+        (ret = a.FromBigInteger(curve.GetG().X)) != 0 ||
+        (ret = b.FromBigInteger(curve.GetG().Y)) != 0)
+    {
+        return ret;
+    }
+    montgomery.Init(p);
+    barrett.Init(p);
+
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        CGXBigInteger tmp(curve.GetG().X);
+        tmp.Multiply(curve.GetG().Y);
+        tmp.Mod(curve.GetP());
+    }
+    snprintf(name, sizeof(name), "%s/mulmod/biginteger", curveName);
+    CGXBenchmark::Report("bigint", name, count, CGXBenchmark::Now() - start, "op/s");
+
+    CGXFixedInteger<BITS> ma, mb;
+    montgomery.ToMontgomery(ma, a);
+    montgomery.ToMontgomery(mb, b);
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        montgomery.Multiply(ma, ma, mb);
+    }
+    Consume(ma);
+    snprintf(name, sizeof(name), "%s/mulmod/montgomery", curveName);
+    CGXBenchmark::Report("bigint", name, count, CGXBenchmark::Now() - start, "op/s");
+
+    r = a;
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        barrett.Multiply(r, r, b);
+    }
+    Consume(r);
+    snprintf(name, sizeof(name), "%s/mulmod/barrett", curveName);
+    CGXBenchmark::Report("bigint", name, count, CGXBenchmark::Now() - start, "op/s");
+
+    //Inversion is much slower. Fewer rounds are used.
+    int inverses = count / 100 + 1;
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != inverses; ++pos)
+    {
+        CGXBigInteger tmp(curve.GetG().X);
+        tmp.Inv(curve.GetP());
+    }
+    snprintf(name, sizeof(name), "%s/invmod/biginteger", curveName);
+    CGXBenchmark::Report("bigint", name, inverses, CGXBenchmark::Now() - start, "op/s");
+
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != inverses; ++pos)
+    {
+        montgomery.Inverse(ma, ma);
+    }
+    Consume(ma);
+    snprintf(name, sizeof(name), "%s/invmod/montgomery", curveName);
+    CGXBenchmark::Report("bigint", name, inverses, CGXBenchmark::Now() - start, "op/s");
+
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != inverses; ++pos)
+    {
+        barrett.Inverse(r, r);
+    }
+    Consume(r);
+    snprintf(name, sizeof(name), "%s/invmod/barrett", curveName);
+    CGXBenchmark::Report("bigint", name, inverses, CGXBenchmark::Now() - start, "op/s");
+    return 0;
+}
+
+/**
+ * Sign and verify with CGXEcdsa.
+ */
+static int SignBenchmark(ECC scheme, const char* curveName, int count)
+{
+    int ret, pos;
+    double start;
+    char name[64];
+    bool valid = false;
+    std::pair<CGXPublicKey, CGXPrivateKey> keys;
+    if ((ret = CGXEcdsa::GenerateKeyPair(scheme, keys)) != 0)
+    {
+        return ret;
+    }
+    CGXByteBuffer data, signature;
+    data.SetHexString2("4D4D4D0000BC614E4D4D4D0000000001");
+    CGXEcdsa signer(keys.second);
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        data.SetPosition(0);
+        signature.Clear();
+        if ((ret = signer.Sign(data, signature)) != 0)
+        {
+            return ret;
+        }
+    }
+    snprintf(name, sizeof(name), "%s/sign", curveName);
+    CGXBenchmark::Report("bigint", name, count, CGXBenchmark::Now() - start, "op/s");
+    CGXEcdsa verifier(keys.first);
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        data.SetPosition(0);
+        if ((ret = verifier.Verify(signature, data, valid)) != 0 || !valid)
+        {
+            return ret != 0 ? ret : DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    snprintf(name, sizeof(name), "%s/verify", curveName);
+    CGXBenchmark::Report("bigint", name, count, CGXBenchmark::Now() - start, "op/s");
+    return 0;
+}
+
+int BigIntegerBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int count = argc > 0 ? atoi(argv[0]) : 100000;
+    if (count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if ((ret = FieldBenchmark<256>(ECC_P256, "P-256", count)) != 0 ||
+        (ret = FieldBenchmark<384>(ECC_P384, "P-384", count)) != 0 ||
+        (ret = SignBenchmark(ECC_P256, "P-256", count / 1000 + 1)) != 0 ||
+        (ret = SignBenchmark(ECC_P384, "P-384", count / 1000 + 1)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXCertificateCache.h"
+#include "../../development/include/GXEcdsa.h"
+
+//Self-signed P-256 test certificate.
+static const char* CERTIFICATE =
+"-----BEGIN CERTIFICATE-----\n"
+"MIIBnTCCAUOgAwIBAgIUWWPP1fg1unKrP2gZ+3k3/onn7x4wCgYIKoZIzj0EAwIw\n"
+"GzEZMBcGA1UEAwwQNEQ0RDREMDAwMEJDNjE0RTAgFw0yNjEwMTkwNzE5MTJaGA8y\n"
+"MTI2MDkyNTA3MTkxMlowGzEZMBcGA1UEAwwQNEQ0RDREMDAwMEJDNjE0RTBZMBMG\n"
+"ByqGSM49AgEGCCqGSM49AwEHA0IABBLDJkLPzCmFSL+DSqaX1Pfkza1QfJfqGet8\n"
+"87BUa7SNOQoUcc2bmtBunFHkFsvlRp3yHkd0SJW+KF+mMvULdTejYzBhMB0GA1Ud\n"
+"DgQWBBRR4sOP+RGO4g/fK0iUINcTokh0BjAfBgNVHSMEGDAWgBRR4sOP+RGO4g/f\n"
+"K0iUINcTokh0BjAPBgNVHRMBAf8EBTADAQH/MA4GA1UdDwEB/wQEAwIHgDAKBggq\n"
+"hkjOPQQDAgNIADBFAiEAv0cpFwOT3eGdFI5wUmqp8oEchiqIC1HW+7bvC3Jz40UC\n"
+"IG3Dnst/PFdMd50wdwRMHAmBJYU0IfHxdJ/mKBZyWte+\n"
+"-----END CERTIFICATE-----\n";
+
+int CertificateCacheBenchmark(int argc, char* argv[])
+{
+    int ret, pos;
+    double start;
+    int count = argc > 0 ? atoi(argv[0]) : 200;
+    if (count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXCertificateCache cache;
+    CGXx509Certificate cert;
+    CGXByteBuffer der, title;
+    title.SetHexString2("4D4D4D0000BC614E");
+    if ((ret = CGXx509Certificate::FromPem(CERTIFICATE, cert)) != 0 ||
+        (ret = cert.GetEncoded(der)) != 0)
+    {
+        return ret;
+    }
+    //Parse certificate as it's received in AARQ/AARE.
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        CGXx509Certificate tmp;
+        der.SetPosition(0);
+        if ((ret = CGXx509Certificate::FromByteArray(der, tmp)) != 0)
+        {
+            return ret;
+        }
+    }
+    CGXBenchmark::Report("certificate", "parse/uncached", count, CGXBenchmark::Now() - start, "op/s");
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        CGXx509Certificate tmp;
+        der.SetPosition(0);
+        if ((ret = cache.GetCertificate(title, der, tmp)) != 0)
+        {
+            return ret;
+        }
+    }
+    CGXBenchmark::Report("certificate", "parse/cached", count, CGXBenchmark::Now() - start, "op/s");
+
+    //Scalar multiplications are slow. Fewer rounds are used.
+    count = count / 20 + 1;
+    std::pair<CGXPublicKey, CGXPrivateKey> client, server;
+    if ((ret = CGXEcdsa::GenerateKeyPair(ECC_P256, client)) != 0 ||
+        (ret = CGXEcdsa::GenerateKeyPair(ECC_P256, server)) != 0)
+    {
+        return ret;
+    }
+    CGXByteBuffer secret, data, signature;
+    data.SetHexString2("4D4D4D0000BC614E4D4D4D0000000001");
+    bool valid = false;
+    CGXEcdsa signer(client.second);
+    if ((ret = signer.Sign(data, signature)) != 0)
+    {
+        return ret;
+    }
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        CGXEcdsa ecdsa(client.first);
+        data.SetPosition(0);
+        signature.SetPosition(0);
+        if ((ret = ecdsa.Verify(signature, data, valid)) != 0 || !valid)
+        {
+            return ret != 0 ? ret : DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    CGXBenchmark::Report("certificate", "verify/uncached", count, CGXBenchmark::Now() - start, "op/s");
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        data.SetPosition(0);
+        signature.SetPosition(0);
+        if ((ret = cache.Verify(client.first, signature, data, valid)) != 0 || !valid)
+        {
+            return ret != 0 ? ret : DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    CGXBenchmark::Report("certificate", "verify/cached", count, CGXBenchmark::Now() - start, "op/s");
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        CGXEcdsa ecdsa(client.second);
+        if ((ret = ecdsa.GenerateSecret(server.first, secret)) != 0)
+        {
+            return ret;
+        }
+    }
+    CGXBenchmark::Report("certificate", "ecdh/uncached", count, CGXBenchmark::Now() - start, "op/s");
+    //Secret is generated once and the rest are read from the cache.
+    count *= 20;
+    start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        if ((ret = cache.GenerateSecret(client.second, server.first, secret)) != 0)
+        {
+            return ret;
+        }
+    }
+    CGXBenchmark::Report("certificate", "ecdh/cached", count, CGXBenchmark::Now() - start, "op/s");
+    return 0;
+}
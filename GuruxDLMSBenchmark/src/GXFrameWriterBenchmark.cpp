@@ -0,0 +1,236 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXDLMSClient.h"
+#include "../../development/include/GXDLMSImageTransfer.h"
+
+/**
+ * Client that generates the messages.
+ */
+static void InitClient(CGXDLMSClient& client)
+{
+    client.SetMaxReceivePDUSize(1024);
+    client.GetHdlcSettings().SetMaxInfoTX(128);
+    client.SetProposedConformance((DLMS_CONFORMANCE)(client.GetProposedConformance() |
+        DLMS_CONFORMANCE_BLOCK_TRANSFER_WITH_SET_OR_WRITE | DLMS_CONFORMANCE_BLOCK_TRANSFER_WITH_ACTION));
+    client.SetNegotiatedConformance(client.GetProposedConformance());
+}
+
+/**
+ * Generate messages to the vector or to the writer.
+ */
+static int Generate(
+    CGXDLMSClient& client,
+    bool image,
+    CGXByteBuffer& value,
+    std::vector<CGXByteBuffer>* messages,
+    CGXDLMSFrameWriter* writer)
+{
+    unsigned long count;
+    CGXDLMSImageTransfer target("0.0.44.0.0.255");
+    target.SetImageBlockSize(200);
+    CGXDLMSVariant name("0.0.96.1.0.255");
+    //Generated PDU moves the position of the value.
+    value.SetPosition(0);
+    if (messages != NULL)
+    {
+        messages->clear();
+        if (image)
+        {
+            return target.ImageBlockTransfer(&client, value, count, *messages);
+        }
+        return client.Write(name, DLMS_OBJECT_TYPE_DATA, 2, value, NULL, *messages);
+    }
+    writer->Clear();
+    if (image)
+    {
+        return target.ImageBlockTransfer(&client, value, count, *writer);
+    }
+    return client.Write(name, DLMS_OBJECT_TYPE_DATA, 2, value, NULL, *writer);
+}
+
+/**
+ * Sum of the bytes. This stands for the send.
+ */
+static unsigned long Send(const unsigned char* data, unsigned long size)
+{
+    unsigned long sum = 0;
+    for (unsigned long pos = 0; pos != size; ++pos)
+    {
+        sum += data[pos];
+    }
+    return sum;
+}
+
+/**
+ * Check that both ways generate the same frames.
+ */
+static int Compare(DLMS_INTERFACE_TYPE type, bool image, CGXByteBuffer& value)
+{
+    int ret;
+    CGXDLMSClient c1(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, type);
+    CGXDLMSClient c2(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, type);
+    InitClient(c1);
+    InitClient(c2);
+    std::vector<CGXByteBuffer> messages;
+    CGXDLMSFrameWriter writer;
+    CGXByteBuffer frame;
+    if ((ret = Generate(c1, image, value, &messages, NULL)) != 0 ||
+        (ret = Generate(c2, image, value, NULL, &writer)) != 0)
+    {
+        return ret;
+    }
+    if (messages.size() != writer.GetCount())
+    {
+        return DLMS_ERROR_CODE_INVALID_RESPONSE;
+    }
+    for (unsigned long pos = 0; pos != writer.GetCount(); ++pos)
+    {
+        if ((ret = writer.GetFrame(pos, frame)) != 0)
+        {
+            return ret;
+        }
+        if (frame.GetSize() != messages[pos].GetSize() ||
+            memcmp(frame.GetData(), messages[pos].GetData(), frame.GetSize()) != 0)
+        {
+            printf("Frame %lu differs.\n%s\n%s\n", pos,
+                frame.ToHexString().c_str(), messages[pos].ToHexString().c_str());
+            return DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    return 0;
+}
+
+static int Measure(
+    DLMS_INTERFACE_TYPE type,
+    bool image,
+    CGXByteBuffer& value,
+    bool useWriter,
+    int count)
+{
+    int ret;
+    char name[64];
+    const unsigned char* data;
+    unsigned long size, sum = 0, frames = 0, bytes = 0;
+    CGXDLMSClient client(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, type);
+    InitClient(client);
+    std::vector<CGXByteBuffer> messages;
+    CGXDLMSFrameWriter writer;
+    //Buffers of the writer are allocated before the measurement.
+    if ((ret = Generate(client, image, value, useWriter ? NULL : &messages, useWriter ? &writer : NULL)) != 0)
+    {
+        return ret;
+    }
+    double start = CGXBenchmark::Now();
+    CGXBenchmark::StartCounting();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        if ((ret = Generate(client, image, value, useWriter ? NULL : &messages, useWriter ? &writer : NULL)) != 0)
+        {
+            CGXBenchmark::StopCounting();
+            return ret;
+        }
+        if (useWriter)
+        {
+            for (unsigned long index = 0; index != writer.GetCount(); ++index)
+            {
+                for (unsigned long segment = 0; segment != writer.GetSegmentCount(index); ++segment)
+                {
+                    data = writer.GetSegment(index, segment, size);
+                    sum += Send(data, size);
+                    bytes += size;
+                }
+            }
+            frames += writer.GetCount();
+        }
+        else
+        {
+            for (std::vector<CGXByteBuffer>::iterator it = messages.begin(); it != messages.end(); ++it)
+            {
+                sum += Send(it->GetData(), it->GetSize());
+                bytes += it->GetSize();
+            }
+            frames += (unsigned long)messages.size();
+        }
+    }
+    CGXBenchmark::StopCounting();
+    double elapsed = CGXBenchmark::Now() - start;
+    snprintf(name, sizeof(name), "%s/%s/%s",
+        type == DLMS_INTERFACE_TYPE_HDLC ? "hdlc" : "wrapper",
+        image ? "image" : "set",
+        useWriter ? "writer" : "copy");
+    CGXBenchmark::Report("frames", name, bytes, elapsed, "MB/s", 1e6);
+    std::string tmp = name;
+    CGXBenchmark::ReportValue("frames", tmp + "/frame", frames, elapsed, 1e9 * elapsed / frames, "ns/frame");
+    CGXBenchmark::ReportValue("frames", tmp + "/new", frames, elapsed,
+        (double)CGXBenchmark::GetAllocations() / frames, "allocations/frame");
+    //Sum is checked so the compiler can't remove the send.
+    return sum == 0 ? DLMS_ERROR_CODE_INVALID_RESPONSE : 0;
+}
+
+int FrameWriterBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int kilobytes = argc > 0 ? atoi(argv[0]) : 64;
+    int count = argc > 1 ? atoi(argv[1]) : 200;
+    if (kilobytes < 1 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXByteBuffer value;
+    value.SetUInt8(DLMS_DATA_TYPE_OCTET_STRING);
+    GXHelpers::SetObjectCount(1024 * kilobytes, value);
+    for (int pos = 0; pos != 1024 * kilobytes; ++pos)
+    {
+        value.SetUInt8((unsigned char)pos);
+    }
+    static const DLMS_INTERFACE_TYPE TYPES[] = { DLMS_INTERFACE_TYPE_HDLC, DLMS_INTERFACE_TYPE_WRAPPER };
+    for (int type = 0; type != 2; ++type)
+    {
+        for (int image = 0; image != 2; ++image)
+        {
+            if ((ret = Compare(TYPES[type], image != 0, value)) != 0 ||
+                (ret = Measure(TYPES[type], image != 0, value, false, count)) != 0 ||
+                (ret = Measure(TYPES[type], image != 0, value, true, count)) != 0)
+            {
+                return ret;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXDLMSSha256.h"
+#include "../../development/include/GXDLMSSha384.h"
+#include "../../development/include/GXDLMSSha1.h"
+#include "../../development/include/GXDLMSMd5.h"
+#include "../../development/include/GXDLMSShaNi.h"
+
+/**
+ * Hash total amount of bytes in blocks of the given size.
+ */
+template <class T>
+static void HashBlocks(
+    const char* algorithm,
+    const char* implementation,
+    CGXByteBuffer& data,
+    unsigned long size,
+    unsigned long long total)
+{
+    char name[64];
+    CGXByteBuffer digest;
+    T hash;
+    unsigned long long count = total / size + 1;
+    double start = CGXBenchmark::Now();
+    for (unsigned long long pos = 0; pos != count; ++pos)
+    {
+        hash.Update(data.GetData(), size);
+        hash.Final(digest);
+    }
+    snprintf(name, sizeof(name), "%s/%s/%lu", algorithm, implementation, size);
+    CGXBenchmark::Report("hash", name, count * size, CGXBenchmark::Now() - start, "GB/s", 1e9);
+}
+
+template <class T>
+static void HashSizes(
+    const char* algorithm,
+    const char* implementation,
+    CGXByteBuffer& data,
+    unsigned long long total)
+{
+    static const unsigned long SIZES[] = { 64, 1024, 65536 };
+    for (int pos = 0; pos != 3; ++pos)
+    {
+        HashBlocks<T>(algorithm, implementation, data, SIZES[pos], total);
+    }
+}
+
+/**
+ * Hash many HLS challenges with one call.
+ */
+static int HashMessages(
+    const char* implementation,
+    std::vector<CGXByteBuffer*>& messages,
+    int rounds)
+{
+    int ret;
+    std::vector<CGXByteBuffer> digests;
+    unsigned long long bytes = 0;
+    for (std::vector<CGXByteBuffer*>::iterator it = messages.begin(); it != messages.end(); ++it)
+    {
+        bytes += (*it)->GetSize();
+    }
+    double start = CGXBenchmark::Now();
+    for (int pos = 0; pos != rounds; ++pos)
+    {
+        if ((ret = CGXDLMSSha256::Hash(messages, digests)) != 0)
+        {
+            return ret;
+        }
+    }
+    std::string name = "sha256/multi-buffer/";
+    name.append(implementation);
+    CGXBenchmark::Report("hash", name, bytes * rounds, CGXBenchmark::Now() - start, "GB/s", 1e9);
+    return 0;
+}
+
+static int HashMessagesOneByOne(
+    std::vector<CGXByteBuffer*>& messages,
+    int rounds)
+{
+    int ret;
+    CGXByteBuffer digest;
+    unsigned long long bytes = 0;
+    for (std::vector<CGXByteBuffer*>::iterator it = messages.begin(); it != messages.end(); ++it)
+    {
+        bytes += (*it)->GetSize();
+    }
+    double start = CGXBenchmark::Now();
+    for (int pos = 0; pos != rounds; ++pos)
+    {
+        for (std::vector<CGXByteBuffer*>::iterator it = messages.begin(); it != messages.end(); ++it)
+        {
+            if ((ret = CGXDLMSSha256::Hash(**it, digest)) != 0)
+            {
+                return ret;
+            }
+        }
+    }
+    CGXBenchmark::Report("hash", "sha256/multi-buffer/sequential", bytes * rounds, CGXBenchmark::Now() - start, "GB/s", 1e9);
+    return 0;
+}
+
+int HashBenchmark(int argc, char* argv[])
+{
+    int ret, pos;
+    unsigned long long total = 1024 * 1024 * (unsigned long long)(argc > 0 ? atoi(argv[0]) : 32);
+    int count = argc > 1 ? atoi(argv[1]) : 1000;
+    if (total == 0 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXByteBuffer data;
+    data.Capacity(65536);
+    for (pos = 0; pos != 65536; ++pos)
+    {
+        data.SetUInt8((unsigned char)pos);
+    }
+    bool shaNi = CGXDLMSShaNi::IsSupported();
+    CGXDLMSShaNi::SetEnabled(false);
+    HashSizes<CGXDLMSSha256>("sha256", "portable", data, total);
+    HashSizes<CGXDLMSSha1>("sha1", "portable", data, total);
+    if (shaNi)
+    {
+        CGXDLMSShaNi::SetEnabled(true);
+        HashSizes<CGXDLMSSha256>("sha256", "sha-ni", data, total);
+        HashSizes<CGXDLMSSha1>("sha1", "sha-ni", data, total);
+    }
+    HashSizes<CGXDLMSSha384>("sha384", "portable", data, total);
+    HashSizes<CGXDLMSMD5>("md5", "portable", data, total);
+
+    //HLS SHA-256 challenges are secret, system title, invocation counter and challenge.
+    std::vector<CGXByteBuffer> messages(count);
+    std::vector<CGXByteBuffer*> list;
+    for (pos = 0; pos != count; ++pos)
+    {
+        messages[pos].Set(data.GetData() + pos % 1024, 16 + 8 + 4 + 16 + pos % 16);
+        list.push_back(&messages[pos]);
+    }
+    int rounds = (int)(total / (count * 60)) + 1;
+    CGXDLMSShaNi::SetEnabled(false);
+    if ((ret = HashMessagesOneByOne(list, rounds)) != 0 ||
+        (ret = HashMessages("lanes", list, rounds)) != 0)
+    {
+        return ret;
+    }
+    CGXDLMSShaNi::SetEnabled(shaNi);
+    if (shaNi && (ret = HashMessages("sha-ni", list, rounds)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
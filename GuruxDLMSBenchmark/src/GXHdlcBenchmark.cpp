@@ -0,0 +1,237 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../../development/include/GXDLMS.h"
+#include "../../development/include/GXDLMSSettings.h"
+#include "../../development/include/GXReplyData.h"
+
+/**
+ * Pseudo random numbers so every run parses the same stream.
+ */
+static unsigned long NextRandom(unsigned long& seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed & 0xFFFFFFFF;
+}
+
+/**
+ * Add noise between frames. Part of the noise looks like a frame start
+ * so the parser must validate the frame before it is accepted.
+ */
+static void AddNoise(CGXByteBuffer& stream, unsigned long size, unsigned long& seed)
+{
+    for (unsigned long pos = 0; pos < size; ++pos)
+    {
+        unsigned long value = NextRandom(seed);
+        if ((value & 0xF00) == 0 && pos + 3 < size)
+        {
+            stream.SetUInt8(HDLC_FRAME_START_END);
+            stream.SetUInt8((unsigned char)(0xA0 | (value & 0x7)));
+            stream.SetUInt8((unsigned char)(value >> 16));
+            pos += 2;
+        }
+        else
+        {
+            stream.SetUInt8((unsigned char)value);
+        }
+    }
+}
+
+/**
+ * Generate UI frames from the meter to the client with noise between them.
+ */
+static int CreateStream(
+    int frames,
+    int noise,
+    CGXByteBuffer& stream)
+{
+    int ret;
+    unsigned long seed = 0x12345678;
+    CGXDLMSSettings settings(true);
+    settings.SetClientAddress(16);
+    settings.SetServerAddress(1);
+    CGXByteBuffer data, frame;
+    for (int pos = 0; pos != frames; ++pos)
+    {
+        unsigned long size = 20 + NextRandom(seed) % 180;
+        data.Clear();
+        data.SetUInt8(0xE6);
+        data.SetUInt8(0xE7);
+        data.SetUInt8(0);
+        for (unsigned long i = 0; i != size; ++i)
+        {
+            data.SetUInt8((unsigned char)NextRandom(seed));
+        }
+        if ((ret = CGXDLMS::GetHdlcFrame(settings, 0x13, &data, frame)) != 0)
+        {
+            return ret;
+        }
+        if (noise != 0)
+        {
+            AddNoise(stream, frame.GetSize() * noise / (100 - noise), seed);
+        }
+        stream.Set(&frame);
+    }
+    return 0;
+}
+
+/**
+ * Parse received frames. Returns amount of parsed frames.
+ */
+static int ParseFrames(
+    CGXDLMSSettings& settings,
+    CGXByteBuffer& reply,
+    CGXReplyData& data,
+    int& errors)
+{
+    int ret, frames = 0;
+    unsigned char frame;
+    while (reply.GetPosition() != reply.GetSize())
+    {
+        unsigned long pos = reply.GetPosition();
+        data.Clear();
+        if ((ret = CGXDLMS::GetHdlcData(false, settings, reply, data, frame, NULL)) != 0)
+        {
+            ++errors;
+            if (reply.GetPosition() == pos)
+            {
+                reply.SetPosition(pos + 1);
+            }
+            continue;
+        }
+        if (!data.IsComplete())
+        {
+            break;
+        }
+        ++frames;
+        // Move after the end flag.
+        reply.SetPosition(data.GetPacketLength() + 3);
+    }
+    return frames;
+}
+
+/**
+ * Parse the stream. The stream is received in chunks if chunk is given.
+ */
+static void Parse(
+    const char* name,
+    CGXByteBuffer& stream,
+    unsigned long chunk,
+    int frames,
+    int rounds)
+{
+    char tmp[64];
+    CGXDLMSSettings settings(false);
+    settings.SetClientAddress(16);
+    settings.SetServerAddress(1);
+    CGXReplyData data;
+    CGXByteBuffer reply;
+    int parsed = 0, errors = 0;
+    double start = CGXBenchmark::Now();
+    for (int round = 0; round != rounds; ++round)
+    {
+        parsed = errors = 0;
+        if (chunk == 0)
+        {
+            stream.SetPosition(0);
+            parsed = ParseFrames(settings, stream, data, errors);
+        }
+        else
+        {
+            reply.Clear();
+            for (unsigned long pos = 0; pos < stream.GetSize(); pos += chunk)
+            {
+                unsigned long size = stream.GetSize() - pos < chunk ? stream.GetSize() - pos : chunk;
+                reply.Set(stream.GetData() + pos, size);
+                parsed += ParseFrames(settings, reply, data, errors);
+                reply.Trim();
+            }
+        }
+    }
+    double elapsed = CGXBenchmark::Now() - start;
+    CGXBenchmark::Report("hdlc", name, (unsigned long long)stream.GetSize() * rounds, elapsed, "MB/s", 1e6);
+    snprintf(tmp, sizeof(tmp), "%s/frames", name);
+    CGXBenchmark::ReportValue("hdlc", tmp, rounds, elapsed, 100.0 * parsed / frames, "% recovered");
+    if (errors != 0)
+    {
+        snprintf(tmp, sizeof(tmp), "%s/errors", name);
+        CGXBenchmark::ReportValue("hdlc", tmp, rounds, elapsed, errors, "errors/round");
+    }
+}
+
+/**
+ * Parse one stream with the given noise level.
+ */
+static int ParseStream(int frames, int noise, int rounds)
+{
+    int ret;
+    char name[64];
+    CGXByteBuffer stream;
+    if ((ret = CreateStream(frames, noise, stream)) != 0)
+    {
+        return ret;
+    }
+    snprintf(name, sizeof(name), "noise=%d%%/whole", noise);
+    Parse(name, stream, 0, frames, rounds);
+    snprintf(name, sizeof(name), "noise=%d%%/chunk=32", noise);
+    Parse(name, stream, 32, frames, rounds);
+    return 0;
+}
+
+int HdlcBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int frames = argc > 0 ? atoi(argv[0]) : 10000;
+    int noise = argc > 1 ? atoi(argv[1]) : -1;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    if (frames < 1 || noise > 90 || rounds < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if (noise != -1)
+    {
+        return ParseStream(frames, noise, rounds);
+    }
+    if ((ret = ParseStream(frames, 0, rounds)) != 0 ||
+        (ret = ParseStream(frames, 10, rounds)) != 0)
+    {
+        return ret;
+    }
+    return ParseStream(frames, 30, rounds);
+}
@@ -0,0 +1,243 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/GXBenchmark.h"
+#include "../include/GXBenchmarkServer.h"
+#include "../../development/include/GXDLMSCompactData.h"
+#include "../../development/include/GXDLMSAssociationLogicalName.h"
+#include "../../development/include/GXDLMSData.h"
+
+/**
+ * Server that can give the compact buffer in PreRead the same way as
+ * an application that reads the whole value from the storage.
+ */
+class CGXLongReadServer : public CGXBenchmarkServer
+{
+public:
+    /**
+     * Is the whole value given in PreRead.
+     */
+    bool m_Materialize;
+
+    /**
+     * Heap usage after the first block.
+     */
+    size_t m_FirstBlockHeap;
+
+    CGXLongReadServer() : CGXBenchmarkServer(true, DLMS_INTERFACE_TYPE_WRAPPER)
+    {
+        m_Materialize = false;
+        m_FirstBlockHeap = 0;
+    }
+
+    void PreRead(std::vector<CGXDLMSValueEventArg*>& args)
+    {
+        for (std::vector<CGXDLMSValueEventArg*>::iterator it = args.begin(); it != args.end(); ++it)
+        {
+            if (m_Materialize && (*it)->GetIndex() == 2 &&
+                (*it)->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_COMPACT_DATA)
+            {
+                CGXDLMSVariant value = ((CGXDLMSCompactData*)(*it)->GetTarget())->GetBuffer();
+                (*it)->SetValue(value);
+                (*it)->SetHandled(true);
+            }
+        }
+    }
+};
+
+/**
+ * Send the request and receiver ready messages until all data is received.
+ * Heap usage is sampled after the first block.
+ */
+static int Read(
+    CGXLongReadServer& server,
+    CGXDLMSClient& client,
+    CGXByteBuffer& request,
+    CGXReplyData& reply,
+    double& firstBlock)
+{
+    int ret;
+    CGXByteBuffer data, rr;
+    CGXByteBuffer* message = &request;
+    size_t heap = CGXBenchmark::GetHeapUsage();
+    double start = CGXBenchmark::Now();
+    reply.Clear();
+    do
+    {
+        data.Clear();
+        if ((ret = server.HandleRequest(*message, data)) != 0)
+        {
+            return ret;
+        }
+        if(getenv("TR")) fprintf(stderr,"REQ %s\nRSP %s\n", message->ToHexString(8, message->GetSize()-8<12?message->GetSize()-8:12, true).c_str(), data.ToHexString(8, data.GetSize()-8<12?data.GetSize()-8:12,true).c_str());
+        if (message == &request)
+        {
+            firstBlock += CGXBenchmark::Now() - start;
+            size_t used = CGXBenchmark::GetHeapUsage();
+            if (used > heap && used - heap > server.m_FirstBlockHeap)
+            {
+                server.m_FirstBlockHeap = used - heap;
+            }
+        }
+        if ((ret = client.GetData(data, reply)) != 0)
+        {
+            return ret;
+        }
+        if (!reply.IsMoreData())
+        {
+            break;
+        }
+        rr.Clear();
+        if ((ret = client.ReceiverReady(reply.GetMoreData(), rr)) != 0)
+        {
+            return ret;
+        }
+        message = &rr;
+    } while (true);
+    return 0;
+}
+
+/**
+ * Read compact data buffer or association object list.
+ */
+static int ReadLong(bool objectList, bool materialize, int kilobytes, int objects, int pdu, int window, int count)
+{
+    int ret, pos;
+    char name[96];
+    CGXLongReadServer server;
+    server.m_Materialize = materialize;
+    server.SetMaxReceivePDUSize(pdu);
+    CGXDLMSCompactData* cd = new CGXDLMSCompactData("0.0.66.0.1.255");
+    CGXDLMSAssociationLogicalName* ln = new CGXDLMSAssociationLogicalName();
+    server.GetItems().push_back(cd);
+    server.GetItems().push_back(ln);
+    for (pos = 0; pos != 1024 * kilobytes; ++pos)
+    {
+        cd->GetBuffer().SetUInt8((unsigned char)pos);
+    }
+    if (objectList)
+    {
+        for (pos = 0; pos != objects; ++pos)
+        {
+            snprintf(name, sizeof(name), "0.%d.96.1.%d.255", pos / 250, pos % 250);
+            server.GetItems().push_back(new CGXDLMSData(name));
+        }
+    }
+    if ((ret = server.Initialize()) != 0)
+    {
+        return ret;
+    }
+    CGXDLMSClient client(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, DLMS_INTERFACE_TYPE_WRAPPER);
+    client.SetMaxReceivePDUSize(pdu);
+    if (window != 0)
+    {
+        server.SetConformance((DLMS_CONFORMANCE)(server.GetConformance() | DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER));
+        client.SetProposedConformance((DLMS_CONFORMANCE)(client.GetProposedConformance() | DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER));
+        client.SetGbtWindowSize(window);
+    }
+    if ((ret = server.Connect(client)) != 0)
+    {
+        return ret;
+    }
+    std::vector<CGXByteBuffer> messages;
+    CGXReplyData reply;
+    if ((ret = client.Read(objectList ? (CGXDLMSObject*)ln : cd, 2, messages)) != 0)
+    {
+        return ret;
+    }
+    double firstBlock = 0;
+    double start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        if ((ret = Read(server, client, messages[0], reply, firstBlock)) != 0)
+        {
+            return ret;
+        }
+        if (objectList ? reply.GetValue().Arr.size() != (size_t)ln->GetObjectList().size() :
+            reply.GetValue().GetSize() != (int)cd->GetBuffer().GetSize())
+        {
+            printf("Invalid reply.\n");
+            return DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    double elapsed = CGXBenchmark::Now() - start;
+    if (objectList)
+    {
+        snprintf(name, sizeof(name), "objects/produced/objects=%d/pdu=%d", objects, pdu);
+    }
+    else
+    {
+        snprintf(name, sizeof(name), "compact/%s/kB=%d/pdu=%d",
+            materialize ? "materialized" : "produced", kilobytes, pdu);
+    }
+    if (window != 0)
+    {
+        snprintf(name + strlen(name), sizeof(name) - strlen(name), "/window=%d", window);
+    }
+    CGXBenchmark::Report("longread", name, count, elapsed, "reads/s");
+    CGXBenchmark::ReportValue("longread", name, count, elapsed,
+        1e6 * firstBlock / count, "us to first block");
+    CGXBenchmark::ReportValue("longread", name, count, elapsed,
+        server.m_FirstBlockHeap / 1024.0, "kB heap after first block");
+    return 0;
+}
+
+int LongReadBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int kilobytes = argc > 0 ? atoi(argv[0]) : 60;
+    int objects = argc > 1 ? atoi(argv[1]) : 5000;
+    int pdu = argc > 2 ? atoi(argv[2]) : 1024;
+    int window = argc > 3 ? atoi(argv[3]) : 0;
+    int count = argc > 4 ? atoi(argv[4]) : 10;
+    //Octet string of the variant is limited to 64 kB.
+    if (kilobytes < 1 || kilobytes > 63 || objects < 1 || pdu < 64 || window < 0 || window > 63 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    for (int w = 0; w != 2; ++w)
+    {
+        int gbt = w == 0 ? window : (window == 0 ? 8 : 0);
+        if ((ret = ReadLong(false, true, kilobytes, objects, pdu, gbt, count)) != 0 ||
+            (ret = ReadLong(false, false, kilobytes, objects, pdu, gbt, count)) != 0 ||
+            (ret = ReadLong(true, false, kilobytes, objects, pdu, gbt, count)) != 0)
+        {
+            return ret;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../include/GXBenchmarkServer.h"
+#include "../../development/include/GXDLMSProfileGeneric.h"
+#include "../../development/include/GXDLMSClock.h"
+#include "../../development/include/GXDLMSRegister.h"
+#include "../../development/include/GXDLMSData.h"
+
+/**
+ * Server that keeps profile rows in own storage and gives them to the
+ * framework in PreRead the same way as the server example reads them
+ * from the file.
+ */
+class CGXProfileServer : public CGXBenchmarkServer
+{
+public:
+    /**
+     * Stored rows.
+     */
+    std::vector<std::vector<CGXDLMSVariant> > m_Rows;
+
+    /**
+     * Are rows given in PreRead. If false, all rows are in the buffer
+     * of the profile generic.
+     */
+    bool m_Stored;
+
+    /**
+     * Amount of rows that are given in PreRead.
+     */
+    unsigned long m_Fetched;
+
+    CGXProfileServer() : CGXBenchmarkServer(true, DLMS_INTERFACE_TYPE_WRAPPER)
+    {
+        m_Stored = false;
+        m_Fetched = 0;
+    }
+
+    void PreRead(std::vector<CGXDLMSValueEventArg*>& args)
+    {
+        for (std::vector<CGXDLMSValueEventArg*>::iterator it = args.begin(); it != args.end(); ++it)
+        {
+            if (!m_Stored || (*it)->GetIndex() != 2 ||
+                (*it)->GetTarget()->GetObjectType() != DLMS_OBJECT_TYPE_PROFILE_GENERIC)
+            {
+                continue;
+            }
+            CGXDLMSProfileGeneric* pg = (CGXDLMSProfileGeneric*)(*it)->GetTarget();
+            if ((*it)->GetRowEndIndex() == 0)
+            {
+                (*it)->SetRowEndIndex((unsigned int)m_Rows.size());
+            }
+            unsigned int count = (*it)->GetRowEndIndex() - (*it)->GetRowBeginIndex();
+            // Read only rows that can fit to one PDU.
+            if (count > (*it)->GetRowToPdu())
+            {
+                count = (*it)->GetRowToPdu();
+            }
+            m_Fetched += count;
+            pg->GetBuffer().clear();
+            for (unsigned int pos = 0; pos != count; ++pos)
+            {
+                pg->GetBuffer().push_back(m_Rows[(*it)->GetRowBeginIndex() + pos]);
+            }
+        }
+    }
+};
+
+/**
+ * Read profile generic that has date-time, integer and variable length
+ * string columns. General block transfer is used if window is given.
+ */
+static int ReadProfile(bool stored, int rows, int pdu, int window, int count)
+{
+    int ret, pos;
+    char name[64];
+    CGXProfileServer server;
+    server.m_Stored = stored;
+    server.SetMaxReceivePDUSize(pdu);
+    CGXDLMSClock* clock = new CGXDLMSClock();
+    CGXDLMSRegister* energy = new CGXDLMSRegister("1.0.1.8.0.255");
+    CGXDLMSData* status = new CGXDLMSData("0.0.96.10.1.255");
+    CGXDLMSData* event = new CGXDLMSData("0.0.96.11.0.255");
+    CGXDLMSData* label = new CGXDLMSData("0.0.96.1.0.255");
+    CGXDLMSProfileGeneric* pg = new CGXDLMSProfileGeneric("1.0.99.1.0.255");
+    pg->AddCaptureObject(clock, 2, 0);
+    pg->AddCaptureObject(energy, 2, 0);
+    pg->AddCaptureObject(status, 2, 0);
+    pg->AddCaptureObject(event, 2, 0);
+    pg->AddCaptureObject(label, 2, 0);
+    server.GetItems().push_back(clock);
+    server.GetItems().push_back(energy);
+    server.GetItems().push_back(status);
+    server.GetItems().push_back(event);
+    server.GetItems().push_back(label);
+    server.GetItems().push_back(pg);
+    for (pos = 0; pos != rows; ++pos)
+    {
+        std::vector<CGXDLMSVariant> row;
+        CGXDateTime tm(2024, 1, 1 + pos / 96 % 28, pos / 4 % 24, pos % 4 * 15, 0, 0);
+        row.push_back(tm);
+        row.push_back((unsigned long)(1000 + 7 * pos));
+        row.push_back((unsigned char)(pos % 8));
+        //Event data is 0 - 39 bytes.
+        CGXByteBuffer bb;
+        for (int i = 0; i != pos * 7 % 40; ++i)
+        {
+            bb.SetUInt8((unsigned char)i);
+        }
+        row.push_back(bb);
+        snprintf(name, sizeof(name), "meter %d", pos);
+        row.push_back(name);
+        if (stored)
+        {
+            server.m_Rows.push_back(row);
+        }
+        else
+        {
+            pg->GetBuffer().push_back(row);
+        }
+    }
+    pg->SetProfileEntries(rows);
+    if ((ret = server.Initialize()) != 0)
+    {
+        return ret;
+    }
+    CGXDLMSClient client(true, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, DLMS_INTERFACE_TYPE_WRAPPER);
+    client.SetMaxReceivePDUSize(pdu);
+    if (window != 0)
+    {
+        server.SetConformance((DLMS_CONFORMANCE)(server.GetConformance() | DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER));
+        client.SetProposedConformance((DLMS_CONFORMANCE)(client.GetProposedConformance() | DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER));
+        client.SetGbtWindowSize(window);
+    }
+    if ((ret = server.Connect(client)) != 0)
+    {
+        return ret;
+    }
+    std::vector<CGXByteBuffer> messages;
+    CGXReplyData reply;
+    if ((ret = client.Read(pg, 2, messages)) != 0)
+    {
+        return ret;
+    }
+    server.ResetReplies();
+    server.m_Fetched = 0;
+    double start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        if ((ret = server.Exchange(client, messages, reply)) != 0)
+        {
+            return ret;
+        }
+        if (reply.GetValue().Arr.size() != (size_t)rows)
+        {
+            printf("Expected %d rows. Received %d.\n", rows, (int)reply.GetValue().Arr.size());
+            return DLMS_ERROR_CODE_INVALID_RESPONSE;
+        }
+    }
+    double elapsed = CGXBenchmark::Now() - start;
+    if (window != 0)
+    {
+        snprintf(name, sizeof(name), "%s/rows=%d/pdu=%d/window=%d", stored ? "stored" : "memory", rows, pdu, window);
+    }
+    else
+    {
+        snprintf(name, sizeof(name), "%s/rows=%d/pdu=%d", stored ? "stored" : "memory", rows, pdu);
+    }
+    CGXBenchmark::Report("profile", name, count, elapsed, "reads/s");
+    CGXBenchmark::ReportValue("profile", name, count, elapsed,
+        (double)server.GetReplies() / count, "blocks/read");
+    CGXBenchmark::ReportValue("profile", name, count, elapsed,
+        (double)server.GetReplyBytes() / server.GetReplies(), "bytes/block");
+    if (stored)
+    {
+        CGXBenchmark::ReportValue("profile", name, count, elapsed,
+            (double)server.m_Fetched / count, "fetched rows/read");
+    }
+    return 0;
+}
+
+int ProfileBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int rows = argc > 0 ? atoi(argv[0]) : 1000;
+    int pdu = argc > 1 ? atoi(argv[1]) : 0;
+    int window = argc > 2 ? atoi(argv[2]) : 0;
+    int count = argc > 3 ? atoi(argv[3]) : 50;
+    if (rows < 1 || pdu < 0 || window < 0 || window > 63 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if (pdu != 0)
+    {
+        if ((ret = ReadProfile(false, rows, pdu, window, count)) != 0 ||
+            (ret = ReadProfile(true, rows, pdu, window, count)) != 0)
+        {
+            return ret;
+        }
+        return 0;
+    }
+    if ((ret = ReadProfile(false, rows, 256, 0, count)) != 0 ||
+        (ret = ReadProfile(true, rows, 256, 0, count)) != 0 ||
+        (ret = ReadProfile(false, rows, 1024, 0, count)) != 0 ||
+        (ret = ReadProfile(true, rows, 1024, 0, count)) != 0 ||
+        (ret = ReadProfile(false, rows, 256, 4, count)) != 0 ||
+        (ret = ReadProfile(true, rows, 256, 4, count)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
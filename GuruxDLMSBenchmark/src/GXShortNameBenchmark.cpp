@@ -0,0 +1,130 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/GXBenchmark.h"
+#include "../include/GXBenchmarkServer.h"
+#include "../../development/include/GXDLMSData.h"
+
+/**
+ * Read the given amount of variables from a short name server with
+ * the given amount of objects.
+ * Each data object uses 16 short names so about 4000 objects fit
+ * to the short name space.
+ */
+static int ReadVariables(int objects, int variables, int count)
+{
+    int ret, pos;
+    char name[64];
+    CGXBenchmarkServer server(false, DLMS_INTERFACE_TYPE_WRAPPER);
+    for (pos = 0; pos != objects; ++pos)
+    {
+        char ln[32];
+        snprintf(ln, sizeof(ln), "0.0.%d.%d.%d.255", 96 + pos / 65536, (pos / 256) % 256, pos % 256);
+        CGXDLMSData* data = new CGXDLMSData(ln);
+        CGXDLMSVariant value((unsigned long)pos);
+        data->SetValue(value);
+        server.GetItems().push_back(data);
+    }
+    if ((ret = server.Initialize()) != 0)
+    {
+        return ret;
+    }
+    CGXDLMSClient client(false, 16, 1, DLMS_AUTHENTICATION_NONE, NULL, DLMS_INTERFACE_TYPE_WRAPPER);
+    if ((ret = server.Connect(client)) != 0)
+    {
+        return ret;
+    }
+    //Variables are spread over all objects.
+    std::vector<std::pair<CGXDLMSObject*, unsigned char> > list;
+    for (pos = 0; pos != variables; ++pos)
+    {
+        list.push_back(std::pair<CGXDLMSObject*, unsigned char>(
+            server.GetItems()[(size_t)pos * objects / variables], 2));
+    }
+    std::vector<CGXByteBuffer> messages;
+    CGXReplyData reply;
+    if ((ret = client.ReadList(list, messages)) != 0 ||
+        (ret = server.Exchange(client, messages, reply)) != 0)
+    {
+        return ret;
+    }
+    //Check that the right objects are read.
+    if (reply.GetValue().Arr.size() != (size_t)variables ||
+        reply.GetValue().Arr[variables - 1].ToInteger() != (variables - 1) * objects / variables)
+    {
+        return DLMS_ERROR_CODE_INVALID_RESPONSE;
+    }
+    CGXByteBuffer data;
+    double start = CGXBenchmark::Now();
+    for (pos = 0; pos != count; ++pos)
+    {
+        for (std::vector<CGXByteBuffer>::iterator it = messages.begin(); it != messages.end(); ++it)
+        {
+            data.Clear();
+            if ((ret = server.HandleRequest(*it, data)) != 0)
+            {
+                return ret;
+            }
+        }
+    }
+    snprintf(name, sizeof(name), "objects=%d/variables=%d", objects, variables);
+    CGXBenchmark::Report("shortname", name, count, CGXBenchmark::Now() - start, "requests/s");
+    return 0;
+}
+
+int ShortNameBenchmark(int argc, char* argv[])
+{
+    int ret;
+    int objects = argc > 0 ? atoi(argv[0]) : 0;
+    int variables = argc > 1 ? atoi(argv[1]) : 100;
+    int count = argc > 2 ? atoi(argv[2]) : 2000;
+    if (objects < 0 || variables < 1 || count < 1)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if (objects != 0)
+    {
+        return ReadVariables(objects, variables, count);
+    }
+    if ((ret = ReadVariables(100, variables, count)) != 0 ||
+        (ret = ReadVariables(1000, variables, count)) != 0 ||
+        (ret = ReadVariables(3000, variables, count)) != 0)
+    {
+        return ret;
+    }
+    return 0;
+}
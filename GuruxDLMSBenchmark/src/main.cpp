@@ -0,0 +1,110 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include <string.h>
+#include "../include/GXBenchmark.h"
+
+typedef int(*BENCHMARK)(int argc, char* argv[]);
+
+/**
+ * Available benchmarks.
+ */
+static struct
+{
+    const char* name;
+    const char* description;
+    BENCHMARK function;
+} BENCHMARKS[] =
+{
+    { "batch", "Parallel decrypt and decode of captured APDUs. Options: [count] [titles] [threads].", BatchDecoderBenchmark },
+    { "certificate", "Certificate, signature and ECDH secret cache. Options: [count].", CertificateCacheBenchmark },
+    { "bigint", "Modular arithmetic, ECDSA sign and verify. Options: [count].", BigIntegerBenchmark },
+    { "hash", "Hash throughput. Options: [megabytes] [messages].", HashBenchmark },
+    { "shortname", "Short name read request. Options: [objects] [variables] [count].", ShortNameBenchmark },
+    { "allocations", "Heap allocations of get request with list. Options: [variables] [count].", AllocationBenchmark },
+    { "profile", "Profile generic read in blocks. Options: [rows] [pdu] [window] [count].", ProfileBenchmark },
+    { "hdlc", "HDLC frame parsing with noise between frames. Options: [frames] [noise %] [rounds].", HdlcBenchmark },
+    { "frames", "Frame generation with copies and with the frame writer. Options: [kilobytes] [count].", FrameWriterBenchmark },
+    { "longread", "Large values read in blocks when serialized at once and when produced per block. Options: [kilobytes] [objects] [pdu] [window] [count].", LongReadBenchmark },
+};
+
+static void ShowHelp()
+{
+    printf("Gurux DLMS benchmarks.\n");
+    printf("gurux.dlms.benchmark.bin [benchmark [options]]\n");
+    printf("All benchmarks are run with default options if benchmark is not given.\n");
+    for (size_t pos = 0; pos != sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); ++pos)
+    {
+        printf(" %s\t%s\n", BENCHMARKS[pos].name, BENCHMARKS[pos].description);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int ret = 0;
+    size_t pos, count = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+    if (argc > 1 && (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0))
+    {
+        ShowHelp();
+        return 0;
+    }
+    CGXBenchmark::PrintHeader();
+    for (pos = 0; pos != count; ++pos)
+    {
+        if (argc < 2)
+        {
+            if ((ret = BENCHMARKS[pos].function(0, NULL)) != 0)
+            {
+                break;
+            }
+        }
+        else if (strcmp(argv[1], BENCHMARKS[pos].name) == 0)
+        {
+            ret = BENCHMARKS[pos].function(argc - 2, argv + 2);
+            break;
+        }
+    }
+    if (argc > 1 && pos == count)
+    {
+        ShowHelp();
+        return 1;
+    }
+    if (ret != 0)
+    {
+        printf("Benchmark failed: %d\n", ret);
+    }
+    return ret;
+}
@@ -134,12 +134,17 @@ public:
 
     //Send data to the media.
     int SendData(CGXByteBuffer& data);
+    //Send frame to the media without copying it to one buffer.
+    int SendData(CGXDLMSFrameWriter& writer, unsigned long index);
     //Read data from the media.
     int ReadData(CGXByteBuffer& reply, std::string& str);
 
+    //Send data or frame of the writer and read reply.
+    int ReadDLMSPacket(CGXByteBuffer* data, CGXDLMSFrameWriter* writer, unsigned long index, CGXReplyData& reply);
     int ReadDLMSPacket(CGXByteBuffer& data, CGXReplyData& reply);
     int ReadDataBlock(CGXByteBuffer& data, CGXReplyData& reply);
     int ReadDataBlock(std::vector<CGXByteBuffer>& data, CGXReplyData& reply);
+    int ReadDataBlock(CGXDLMSFrameWriter& writer, CGXReplyData& reply);
 
     int InitializeConnection();
 
@@ -1138,6 +1138,44 @@ int CGXCommunication::SendData(CGXByteBuffer& data)
     return 0;
 }
 
+int CGXCommunication::SendData(CGXDLMSFrameWriter& writer, unsigned long index)
+{
+    int ret;
+    unsigned long size, count = writer.GetSegmentCount(index);
+    if (m_hComPort != INVALID_HANDLE_VALUE || count > 16)
+    {
+        CGXByteBuffer frame;
+        if ((ret = writer.GetFrame(index, frame)) != 0)
+        {
+            return ret;
+        }
+        return SendData(frame);
+    }
+#if defined(_WIN32) || defined(_WIN64)//If Windows
+    WSABUF vec[16];
+    DWORD sent;
+    for (unsigned long pos = 0; pos != count; ++pos)
+    {
+        vec[pos].buf = (char*)writer.GetSegment(index, pos, size);
+        vec[pos].len = size;
+    }
+    if (WSASend(m_socket, vec, count, &sent, 0, NULL, NULL) != 0)
+    {
+        ret = WSAGetLastError();
+        return DLMS_ERROR_TYPE_COMMUNICATION_ERROR | ret;
+    }
+#else
+    struct iovec vec[16];
+    size = writer.GetSize(index);
+    if (writev(m_socket, vec, writer.GetFrame(index, vec)) != (ssize_t)size)
+    {
+        ret = errno;
+        return DLMS_ERROR_TYPE_COMMUNICATION_ERROR | ret;
+    }
+#endif
+    return 0;
+}
+
 int CGXCommunication::ReadData(CGXByteBuffer& reply, std::string& str)
 {
     int ret;
@@ -1193,24 +1231,59 @@ int CGXCommunication::ReadData(CGXByteBuffer& reply, std::string& str)
 
 // Read DLMS Data frame from the device.
 int CGXCommunication::ReadDLMSPacket(CGXByteBuffer& data, CGXReplyData& reply)
+{
+    return ReadDLMSPacket(&data, NULL, 0, reply);
+}
+
+// Send data or frame of the writer and read DLMS Data frame from the device.
+int CGXCommunication::ReadDLMSPacket(
+    CGXByteBuffer* data,
+    CGXDLMSFrameWriter* writer,
+    unsigned long index,
+    CGXReplyData& reply)
 {
     int ret;
     CGXByteBuffer bb;
     std::string tmp;
     CGXReplyData notify;
-    if (data.GetSize() == 0 && !reply.IsStreaming())
+    if (writer == NULL && data->GetSize() == 0 && !reply.IsStreaming())
     {
         return DLMS_ERROR_CODE_OK;
     }
     Now(tmp);
     tmp = "TX:\t" + tmp;
-    tmp += "\t" + data.ToHexString();
+    if (writer == NULL)
+    {
+        tmp += "\t" + data->ToHexString();
+    }
+    else
+    {
+        unsigned long size;
+        tmp += "\t";
+        for (unsigned long pos = 0; pos != writer->GetSegmentCount(index); ++pos)
+        {
+            const unsigned char* segment = writer->GetSegment(index, pos, size);
+            if (pos != 0)
+            {
+                tmp += " ";
+            }
+            tmp += GXHelpers::BytesToHex(segment, size);
+        }
+    }
     if (m_Trace > GX_TRACE_LEVEL_INFO)
     {
         printf("%s\n", tmp.c_str());
     }
     GXHelpers::Write("trace.txt", tmp + "\n");
-    if ((ret = SendData(data)) != 0)
+    if (writer == NULL)
+    {
+        ret = SendData(*data);
+    }
+    else
+    {
+        ret = SendData(*writer, index);
+    }
+    if (ret != 0)
     {
         return ret;
     }
@@ -1247,7 +1320,15 @@ int CGXCommunication::ReadDLMSPacket(CGXByteBuffer& data, CGXReplyData& reply)
             }
             ++pos;
             printf("Data send failed. Try to resend %d/3\n", pos);
-            if ((ret = SendData(data)) != 0)
+            if (writer == NULL)
+            {
+                ret = SendData(*data);
+            }
+            else
+            {
+                ret = SendData(*writer, index);
+            }
+            if (ret != 0)
             {
                 break;
             }
@@ -1266,7 +1347,7 @@ int CGXCommunication::ReadDLMSPacket(CGXByteBuffer& data, CGXReplyData& reply)
 #else
         usleep(1000000);
 #endif
-        ret = ReadDLMSPacket(data, reply);
+        ret = ReadDLMSPacket(data, writer, index, reply);
     }
     return ret;
 }
@@ -1338,6 +1419,37 @@ int CGXCommunication::ReadDataBlock(std::vector<CGXByteBuffer>& data, CGXReplyDa
     return ret;
 }
 
+int CGXCommunication::ReadDataBlock(CGXDLMSFrameWriter& writer, CGXReplyData& reply)
+{
+    int ret = 0;
+    CGXByteBuffer bb;
+    for (unsigned long index = 0; index != writer.GetCount(); ++index)
+    {
+        reply.Clear();
+        //Send frame.
+        if ((ret = ReadDLMSPacket(NULL, &writer, index, reply)) != DLMS_ERROR_CODE_OK)
+        {
+            break;
+        }
+        while (reply.IsMoreData())
+        {
+            bb.Clear();
+            if (!reply.IsStreaming())
+            {
+                if ((ret = m_Parser->ReceiverReady(reply.GetMoreData(), bb)) != 0)
+                {
+                    break;
+                }
+            }
+            if ((ret = ReadDLMSPacket(bb, reply)) != DLMS_ERROR_CODE_OK)
+            {
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
 // This method can be used to update firmware from the hex file.
 //
 int CGXCommunication::ImageUpdateFromFile(
@@ -1410,11 +1522,12 @@ int CGXCommunication::ImageUpdate(CGXDLMSImageTransfer* target,
     }
 
     // Step 3: Transfers ImageBlocks.
+    // Image blocks are sent from the generated PDUs without copying them to each frame.
     unsigned long imageBlockCount;
-    data.clear();
+    CGXDLMSFrameWriter writer;
     reply.Clear();
-    if ((ret = target->ImageBlockTransfer(m_Parser, image, imageBlockCount, data)) != 0 ||
-        (ret = ReadDataBlock(data, reply)) != 0)
+    if ((ret = target->ImageBlockTransfer(m_Parser, image, imageBlockCount, writer)) != 0 ||
+        (ret = ReadDataBlock(writer, reply)) != 0)
     {
         return ret;
     }
@@ -0,0 +1,192 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXCERTIFICATECACHE_H
+#define GXCERTIFICATECACHE_H
+
+#include <map>
+#include <string>
+#include "GXBytebuffer.h"
+#include "GXEccPoint.h"
+#include "GXPublicKey.h"
+#include "GXPrivateKey.h"
+#include "GXx509Certificate.h"
+
+/**
+ * Cache of parsed certificates, public key points and ECDH shared secrets.
+ *
+ * Certificates of the meters and keys of the client rarely change. When the
+ * same cache is shared between the connections, reconnecting to an already
+ * authenticated meter skips ASN.1 parsing of the certificate, the public key
+ * validation and the scalar multiplication of the static-static key
+ * agreement.
+ *
+ * Certificates are cached by system title and SHA-256 hash of the encoded
+ * certificate. Shared secrets are cached by SHA-256 hash of the private key
+ * and the public key so the private key is not copied to the cache.
+ *
+ * Cache is not thread-safe. Use own cache for each thread or synchronize
+ * the access.
+ */
+class CGXCertificateCache
+{
+private:
+    /**
+     * Parsed certificates by system title and certificate hash.
+     */
+    std::map<std::string, CGXx509Certificate> m_Certificates;
+
+    /**
+     * Parsed public key points by raw public key.
+     */
+    std::map<std::string, CGXEccPoint> m_Points;
+
+    /**
+     * Shared secrets by private key hash and raw public key.
+     */
+    std::map<std::string, CGXByteBuffer> m_Secrets;
+
+    /**
+     * Maximum amount of items in each table. Zero is unlimited.
+     */
+    size_t m_MaxSize;
+
+    /**
+     * Amount of cache hits.
+     */
+    unsigned long m_Hits;
+
+    /**
+     * Amount of cache misses.
+     */
+    unsigned long m_Misses;
+
+    /**
+     * Get hash of the data as a map key.
+     */
+    static int GetHash(
+        const unsigned char* data,
+        unsigned long size,
+        std::string& value);
+public:
+    /**
+     * Constructor.
+     *
+     * @param maxSize Maximum amount of items in each table. Zero is unlimited.
+     */
+    CGXCertificateCache(size_t maxSize = 1000);
+
+    /**
+     * @return Maximum amount of items in each table. Zero is unlimited.
+     */
+    size_t GetMaxSize();
+
+    /**
+     * @param value Maximum amount of items in each table. Zero is unlimited.
+     *              Table is cleared when it's full.
+     */
+    void SetMaxSize(size_t value);
+
+    /**
+     * @return Amount of cache hits.
+     */
+    unsigned long GetHits();
+
+    /**
+     * @return Amount of cache misses.
+     */
+    unsigned long GetMisses();
+
+    /**
+     * Get parsed certificate. Certificate is parsed and cached if it's not
+     * found from the cache.
+     *
+     * @param systemTitle System title of the certificate owner. Can be empty.
+     * @param data Encoded certificate.
+     * @param value Parsed certificate.
+     * @return Error code.
+     */
+    int GetCertificate(
+        CGXByteBuffer& systemTitle,
+        CGXByteBuffer& data,
+        CGXx509Certificate& value);
+
+    /**
+     * Get public key as a point of the curve.
+     *
+     * @param key Public key.
+     * @param value Public key point.
+     * @return Error code.
+     */
+    int GetPoint(
+        CGXPublicKey& key,
+        CGXEccPoint& value);
+
+    /**
+     * Verify that signature matches the data using the cached public key point.
+     *
+     * @param key Public key.
+     * @param signature Generated signature.
+     * @param data Signed data.
+     * @param value Is signature valid.
+     * @return Error code.
+     */
+    int Verify(
+        CGXPublicKey& key,
+        CGXByteBuffer& signature,
+        CGXByteBuffer& data,
+        bool& value);
+
+    /**
+     * Get ECDH shared secret of static-static key agreement.
+     * Secret is generated and cached if it's not found from the cache.
+     *
+     * @param privateKey Own private key.
+     * @param publicKey Public key of the other party.
+     * @param secret Shared secret.
+     * @return Error code.
+     */
+    int GenerateSecret(
+        CGXPrivateKey& privateKey,
+        CGXPublicKey& publicKey,
+        CGXByteBuffer& secret);
+
+    /**
+     * Remove all cached items.
+     */
+    void Clear();
+};
+
+#endif //GXCERTIFICATECACHE_H
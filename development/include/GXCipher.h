@@ -39,6 +39,8 @@
 #include "GXPrivateKey.h"
 #include "GXPublicKey.h"
 #include "GXx509Certificate.h"
+#include "GXCipherContext.h"
+#include "GXCertificateCache.h"
 
 #ifdef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
 #include "GXCryptoKeyParameter.h"
@@ -122,6 +124,12 @@ private:
      */
     std::vector<CGXx509Certificate> m_Certificates;
 
+    /**
+     * Shared cache of parsed certificates and key agreement secrets.
+     * Cache is not owned by the cipher.
+     */
+    CGXCertificateCache* m_CertificateCache;
+
     /**
      * Internal initialization method.
      *
@@ -133,6 +141,46 @@ private:
         unsigned char count);
 
 #ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+    /**
+     * Crypto context of the block cipher key.
+     */
+    CGXCipherContext m_BlockCipherContext;
+
+    /**
+     * Crypto context of the dedicated key.
+     */
+    CGXCipherContext m_DedicatedContext;
+
+    /**
+     * Crypto context of the last used other key.
+     */
+    CGXCipherContext m_Context;
+
+    /**
+     * Get crypto context for the key. Context is expanded if the key has changed.
+     *
+     * @param key Encryption/authentication key.
+     * @param suite Security suite.
+     * @param context Crypto context.
+     * @return Error code or 0 on success.
+     */
+    int GetContext(
+        CGXByteBuffer& key,
+        DLMS_SECURITY_SUITE suite,
+        CGXCipherContext*& context);
+
+    /**
+     * Expand AES round keys and GHASH table to the crypto context.
+     *
+     * @param context Crypto context.
+     * @param key Cipher key.
+     * @param keyBits Key size in bits (128 or 256).
+     * @return Error code or 0 on success.
+     */
+    static int InitContext(
+        CGXCipherContext& context,
+        const unsigned char* key,
+        unsigned short keyBits);
 
     /**
      * Initialize AES round keys.
@@ -157,34 +205,27 @@ private:
         const unsigned char* src);
 
     /**
-     * Right shift a 128-bit block by one bit.
+     * Multiply value with the hash subkey H in the Galois field (GF(2^128)).
      *
-     * @param v Block to shift.
-     */
-    static void shift_right_block(unsigned char* v);
-
-    /**
-     * Multiply two values in the Galois field (GF(2^128)).
-     *
-     * @param x First operand.
-     * @param y Second operand.
+     * @param context Crypto context that holds the table of H.
+     * @param x Value to multiply.
      * @param z Result buffer.
      */
     static void MultiplyH(
+        const CGXCipherContext& context,
         const unsigned char* x,
-        const unsigned char* y,
         unsigned char* z);
 
     /**
      * Calculate GHASH for GCM authentication.
      *
-     * @param h Hash subkey.
+     * @param context Crypto context.
      * @param x Input data.
      * @param xlen Length of input data.
      * @param y Output GHASH value (updated in place).
      */
     static void GetGHash(
-        const unsigned char* h,
+        const CGXCipherContext& context,
         const unsigned char* x,
         int xlen,
         unsigned char* y);
@@ -194,13 +235,13 @@ private:
      *
      * @param iv Initialization vector (nonce).
      * @param len Length of IV.
-     * @param H Hash subkey.
+     * @param context Crypto context.
      * @param J0 Output J0 block.
      */
     static void Init_j0(
         const unsigned char* iv,
         unsigned char len,
-        const unsigned char* H,
+        const CGXCipherContext& context,
         unsigned char* J0);
 
     /**
@@ -245,7 +286,7 @@ private:
     /**
      * Calculate GCM authentication tag (GHASH).
      *
-     * @param H Hash subkey.
+     * @param context Crypto context.
      * @param aad Additional authenticated data.
      * @param aad_len Length of AAD.
      * @param crypt Ciphertext.
@@ -253,7 +294,7 @@ private:
      * @param S Output authentication tag.
      */
     static void AesGcmGhash(
-        const unsigned char* H,
+        const CGXCipherContext& context,
         const unsigned char* aad,
         int aad_len,
         const unsigned char* crypt,
@@ -373,6 +414,38 @@ public:
         CGXByteBuffer& data,
         CGXByteBuffer& secret);
 
+    /**
+     * Expand AES-128 round keys for Aes1Encrypt and Aes1Decrypt.
+     *
+     * Expanded keys can be reused when the same secret is used many times.
+     *
+     * @param secret AES-128 key (16 bytes).
+     * @param roundKeys Output round keys (176 bytes).
+     */
+    static void Aes1ExpandKey(
+        const unsigned char* secret,
+        unsigned char* roundKeys);
+
+    /**
+     * Encrypt one block using expanded AES-128 round keys.
+     *
+     * @param data Block to encrypt (16 bytes, modified in place).
+     * @param roundKeys Round keys from Aes1ExpandKey.
+     */
+    static void Aes1Encrypt(
+        unsigned char* data,
+        const unsigned char* roundKeys);
+
+    /**
+     * Decrypt one block using expanded AES-128 round keys.
+     *
+     * @param data Block to decrypt (16 bytes, modified in place).
+     * @param roundKeys Round keys from Aes1ExpandKey.
+     */
+    static void Aes1Decrypt(
+        unsigned char* data,
+        const unsigned char* roundKeys);
+
     /**
      * Check if ciphering is enabled.
      *
@@ -541,5 +614,21 @@ public:
      * @param value Vector of certificates.
      */
     void SetCertificates(std::vector<CGXx509Certificate>& value);
+
+    /**
+     * Get the certificate cache.
+     *
+     * @return Certificate cache or NULL if certificates are not cached.
+     */
+    CGXCertificateCache* GetCertificateCache();
+
+    /**
+     * Set the certificate cache. Same cache can be shared between the
+     * connections so reconnecting to an already authenticated meter
+     * doesn't parse the certificates again. Cache is not owned by the cipher.
+     *
+     * @param value Certificate cache or NULL if certificates are not cached.
+     */
+    void SetCertificateCache(CGXCertificateCache* value);
 };
 #endif //GXCIPHER_H
@@ -0,0 +1,113 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXCIPHERCONTEXT_H
+#define GXCIPHERCONTEXT_H
+
+#include "GXBytebuffer.h"
+
+#ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+
+/**
+ * Crypto context of one AES-GCM key.
+ *
+ * Context holds the expanded AES key, hash subkey H and the GHASH
+ * multiplication table of H. The context is created when the key is used
+ * first time and it's reused until the key changes.
+ */
+class CGXCipherContext
+{
+    friend class CGXCipher;
+private:
+    /**
+     * Key where the context is expanded from.
+     */
+    unsigned char m_Key[32];
+
+    /**
+     * Key size in bits. Zero if context is not initialized.
+     */
+    unsigned short m_KeyBits;
+
+    /**
+     * AES round keys. The last item is the number of rounds.
+     */
+    uint32_t m_RoundKeys[61];
+
+    /**
+     * Hash subkey H.
+     */
+    unsigned char m_H[16];
+
+    /**
+     * Low 64 bits of the GHASH multiplication table of H.
+     */
+    uint64_t m_HL[16];
+
+    /**
+     * High 64 bits of the GHASH multiplication table of H.
+     */
+    uint64_t m_HH[16];
+
+public:
+    /**
+     * Constructor.
+     */
+    CGXCipherContext();
+
+    /**
+     * Destructor. Key material is cleared.
+     */
+    ~CGXCipherContext();
+
+    /**
+     * Is context expanded from the given key.
+     *
+     * @param key Key.
+     * @param keyBits Key size in bits.
+     * @return True, if context can be used with the key.
+     */
+    bool IsValid(
+        const unsigned char* key,
+        unsigned short keyBits);
+
+    /**
+     * Invalidate the context. Context is expanded again when it's used next time.
+     */
+    void Invalidate();
+};
+
+#endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+#endif //GXCIPHERCONTEXT_H
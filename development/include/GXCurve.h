@@ -66,6 +66,7 @@ private:
     */
     CGXBigInteger m_N;
 
+public:
     /**
  Init curve.
 
@@ -192,7 +193,7 @@ private:
         }
         return 0;
     }
-public:
+
     /// <summary>
     /// Constructor.
     /// </summary>
@@ -45,6 +45,7 @@
 #include "GXReplyData.h"
 #include "GXDLMSLNParameters.h"
 #include "GXDLMSSNParameters.h"
+#include "GXDLMSFrameWriter.h"
 
 class CGXDLMS
 {
@@ -222,6 +223,34 @@ public:
         CGXDLMSSNParameters& p,
         std::vector<CGXByteBuffer>& reply);
 
+    /**
+     * Get all Logical name messages without copying the PDU to the frames.
+     * Frames are added after the frames that writer already has.
+     *
+     * @param p
+     *            LN settings.
+     * @param writer
+     *            Generated frames.
+     * @return    Status code.
+     */
+    static int GetLnMessages(
+        CGXDLMSLNParameters& p,
+        CGXDLMSFrameWriter& writer);
+
+    /**
+    * Get all Short Name messages without copying the PDU to the frames.
+    * Frames are added after the frames that writer already has.
+    *
+    * @param p
+    *            DLMS SN parameters.
+    * @param writer
+    *            Generated frames.
+    * @return    Status code.
+    */
+    static int GetSnMessages(
+        CGXDLMSSNParameters& p,
+        CGXDLMSFrameWriter& writer);
+
     /**
     * Handle General block transfer message.
     *
@@ -307,6 +336,38 @@ public:
         CGXByteBuffer* data,
         CGXByteBuffer& reply);
 
+    /**
+    * Add HDLC frame header to the reply. Data is not added.
+    *
+    * settings: DLMS settings.
+    * frame: Frame ID. If zero new is generated.
+    * data: Data to add.
+    * reply: HDLC header is added here.
+    * len: Amount of data that fits to the frame.
+    */
+    static int GetHdlcFrameHeader(
+        CGXDLMSSettings& settings,
+        unsigned char frame,
+        CGXByteBuffer* data,
+        CGXByteBuffer& reply,
+        int& len);
+
+    /**
+    * Add frames of the PDU to the writer.
+    *
+    * settings: DLMS settings.
+    * command: DLMS command.
+    * frame: Frame ID of the first frame. If zero new is generated.
+    * index: PDU index in the writer.
+    * writer: Frame writer.
+    */
+    static int AddFrames(
+        CGXDLMSSettings& settings,
+        DLMS_COMMAND command,
+        unsigned char frame,
+        long index,
+        CGXDLMSFrameWriter& writer);
+
     static int GetHdlcData(
         bool server,
         CGXDLMSSettings& settings,
@@ -41,12 +41,13 @@
 #include "GXDLMSContextType.h"
 #include "GXAuthenticationMechanismName.h"
 #include "GXDLMSObjectCollection.h"
+#include "IGXDLMSValueProducer.h"
 
 /**
 Online help:
 http://www.gurux.fi/Gurux.DLMS.Objects.GXDLMSAssociationLogicalName
 */
-class CGXDLMSAssociationLogicalName : public CGXDLMSObject
+class CGXDLMSAssociationLogicalName : public CGXDLMSObject, public IGXDLMSValueProducer
 {
 private:
 
@@ -78,6 +79,13 @@ private:
         CGXDLMSServer* server,
         CGXByteBuffer& data);
 
+    // Add object to LN Association View.
+    int AppendObject(
+        CGXDLMSSettings& settings,
+        CGXDLMSValueEventArg& e,
+        CGXDLMSObject* pObj,
+        CGXByteBuffer& data);
+
     // Returns LN Association View.
     int GetObjects(
         CGXDLMSSettings& settings,
@@ -189,6 +197,14 @@ public:
 
     int GetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e);
     int SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e);
+
+    // Serialize next part of the object list.
+    int Produce(
+        CGXDLMSSettings& settings,
+        CGXDLMSValueEventArg& e,
+        unsigned long size,
+        CGXByteBuffer& data,
+        bool& completed);
 };
 #endif //DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
 #endif //GXDLMSASSOCIATIONLOGICALNAME_H
\ No newline at end of file
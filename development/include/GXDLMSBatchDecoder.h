@@ -0,0 +1,304 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXDLMSBATCHDECODER_H
+#define GXDLMSBATCHDECODER_H
+
+#include <map>
+#include <vector>
+#include "GXBytebuffer.h"
+#include "GXDLMSVariant.h"
+#include "GXDLMSSettings.h"
+
+/**
+ * Captured ciphered APDU and the result of decrypting and decoding it.
+ */
+class CGXDLMSBatchItem
+{
+private:
+    /**
+     * System title of the sender of the APDU.
+     * General ciphering APDUs carry the system title and this is ignored.
+     */
+    CGXByteBuffer m_SystemTitle;
+
+    /**
+     * Captured ciphered APDU.
+     */
+    CGXByteBuffer m_Data;
+
+    /**
+     * Error code of the decrypt and decode.
+     */
+    int m_Error;
+
+    /**
+     * Used security.
+     */
+    DLMS_SECURITY m_Security;
+
+    /**
+     * Used security suite.
+     */
+    DLMS_SECURITY_SUITE m_SecuritySuite;
+
+    /**
+     * Invocation counter of the APDU.
+     */
+    uint64_t m_InvocationCounter;
+
+    /**
+     * Decrypted command.
+     */
+    DLMS_COMMAND m_Command;
+
+    /**
+     * Decrypted APDU.
+     */
+    CGXByteBuffer m_PlainText;
+
+    /**
+     * Decoded value.
+     */
+    CGXDLMSVariant m_Value;
+
+    friend class CGXDLMSBatchDecoder;
+public:
+    /**
+     * Constructor.
+     */
+    CGXDLMSBatchItem();
+
+    /**
+     * Constructor.
+     *
+     * @param systemTitle System title of the sender.
+     * @param data Captured ciphered APDU.
+     */
+    CGXDLMSBatchItem(
+        CGXByteBuffer& systemTitle,
+        CGXByteBuffer& data);
+
+    /**
+     * @return System title of the sender.
+     */
+    CGXByteBuffer& GetSystemTitle();
+
+    /**
+     * @param value System title of the sender.
+     */
+    void SetSystemTitle(CGXByteBuffer& value);
+
+    /**
+     * @return Captured ciphered APDU.
+     */
+    CGXByteBuffer& GetData();
+
+    /**
+     * @param value Captured ciphered APDU.
+     */
+    void SetData(CGXByteBuffer& value);
+
+    /**
+     * @return Error code or 0 if APDU was decrypted and decoded.
+     */
+    int GetError();
+
+    /**
+     * @return Used security.
+     */
+    DLMS_SECURITY GetSecurity();
+
+    /**
+     * @return Used security suite.
+     */
+    DLMS_SECURITY_SUITE GetSecuritySuite();
+
+    /**
+     * @return Invocation counter of the APDU.
+     */
+    uint64_t GetInvocationCounter();
+
+    /**
+     * @return Decrypted command.
+     */
+    DLMS_COMMAND GetCommand();
+
+    /**
+     * @return Decrypted APDU.
+     */
+    CGXByteBuffer& GetPlainText();
+
+    /**
+     * @return Decoded value.
+     */
+    CGXDLMSVariant& GetValue();
+};
+
+/**
+ * Decrypts and decodes captured ciphered APDUs in parallel.
+ *
+ * Each worker thread owns its own settings and cipher so APDUs from
+ * different meters can be handled at the same time. Results are returned
+ * in the same order as the APDUs were captured.
+ *
+ * Thread safety: decrypting (CGXCipher) and decoding the plain APDU
+ * (CGXDLMS::GetData, CGXDataInfo, CGXDateTime) keep no shared state and
+ * CGXDateTime uses localtime_r/gmtime_r (localtime_s/gmtime_s on Windows).
+ * Keys must not be added or cleared while Decode is running. The decoder
+ * itself is not meant to be shared between threads.
+ *
+ * Glo-*, ded-*, general-glo-ciphering and general-ded-ciphering APDUs are
+ * handled. General-ciphering (DLMS_COMMAND_GENERAL_CIPHERING) is not
+ * supported and it's returned with DLMS_ERROR_CODE_INVALID_PARAMETER.
+ */
+class CGXDLMSBatchDecoder
+{
+private:
+    /**
+     * Keys of one system title.
+     */
+    class CGXDLMSBatchKeys
+    {
+    public:
+        CGXByteBuffer m_BlockCipherKey;
+        CGXByteBuffer m_AuthenticationKey;
+        CGXByteBuffer m_DedicatedKey;
+    };
+
+    /**
+     * Keys by system title.
+     */
+    std::map<std::string, CGXDLMSBatchKeys> m_Keys;
+
+    /**
+     * Is Logical Name referencing used.
+     */
+    bool m_UseLogicalNameReferencing;
+
+    /**
+     * Amount of worker threads.
+     */
+    int m_ThreadCount;
+
+    /**
+     * Decrypt and decode one item.
+     *
+     * @param settings Settings of the worker.
+     * @param item Captured APDU.
+     * @return Error code.
+     */
+    int Decode(
+        CGXDLMSSettings& settings,
+        CGXDLMSBatchItem& item);
+
+    /**
+     * Work of one worker thread.
+     */
+    class CGXDLMSBatchWork
+    {
+    public:
+        CGXDLMSBatchDecoder* m_Decoder;
+        std::vector<CGXDLMSBatchItem>* m_Items;
+        // Index of the first item.
+        size_t m_Index;
+        // Worker handles every m_Step item.
+        size_t m_Step;
+    };
+
+    /**
+     * Decrypt and decode items of one worker.
+     */
+    void DecodeRange(CGXDLMSBatchWork& work);
+
+    /**
+     * Thread entry point.
+     */
+#if defined(_WIN32) || defined(_WIN64)
+    static unsigned int __stdcall Worker(void* parameter);
+#else
+    static void* Worker(void* parameter);
+#endif //defined(_WIN32) || defined(_WIN64)
+public:
+    /**
+     * Constructor.
+     *
+     * @param useLogicalNameReferencing Is Logical Name referencing used.
+     */
+    CGXDLMSBatchDecoder(bool useLogicalNameReferencing = true);
+
+    /**
+     * @return Amount of worker threads. Zero uses all available cores.
+     */
+    int GetThreadCount();
+
+    /**
+     * @param value Amount of worker threads. Zero uses all available cores.
+     */
+    void SetThreadCount(int value);
+
+    /**
+     * Add keys for the system title.
+     *
+     * @param systemTitle System title of the meter.
+     * @param blockCipherKey Block cipher key.
+     * @param authenticationKey Authentication key.
+     * @param dedicatedKey Dedicated key. Can be empty. Ded-* APDUs of the
+     *                     system title are rejected if it's empty.
+     * @return Error code.
+     */
+    int AddKeys(
+        CGXByteBuffer& systemTitle,
+        CGXByteBuffer& blockCipherKey,
+        CGXByteBuffer& authenticationKey,
+        CGXByteBuffer& dedicatedKey);
+
+    /**
+     * Remove all keys.
+     */
+    void ClearKeys();
+
+    /**
+     * Decrypt and decode captured APDUs.
+     *
+     * Result of each APDU is saved to the item.
+     *
+     * @param items Captured APDUs in capture order.
+     * @return Error code. Errors of the single APDUs are returned in the items.
+     */
+    int Decode(std::vector<CGXDLMSBatchItem>& items);
+};
+
+#endif //GXDLMSBATCHDECODER_H
@@ -115,6 +115,29 @@ private:
         CGXByteBuffer* parameters,
         std::vector<CGXByteBuffer>& reply);
 
+    /**
+    * Generates a write message to the reply or to the writer.
+    */
+    int Write(
+        CGXDLMSVariant& name,
+        DLMS_OBJECT_TYPE objectType,
+        int index,
+        CGXByteBuffer& data,
+        CGXByteBuffer* parameters,
+        std::vector<CGXByteBuffer>* reply,
+        CGXDLMSFrameWriter* writer);
+
+    /**
+    * Generate Method (Action) request to the reply or to the writer.
+    */
+    int Method(
+        CGXDLMSVariant name,
+        DLMS_OBJECT_TYPE objectType,
+        int methodIndex,
+        CGXByteBuffer& data,
+        std::vector<CGXByteBuffer>* reply,
+        CGXDLMSFrameWriter* writer);
+
 public:
     /////////////////////////////////////////////////////////////////////////////
     //Constructor
@@ -688,6 +711,32 @@ public:
         CGXByteBuffer* parameters,
         std::vector<CGXByteBuffer>& reply);
 
+    /**
+    * Generates a write message without copying the PDU to the frames.
+    * Large values that are sent in several blocks are not copied to each frame.
+    *
+    * @param name
+    *            Short or Logical Name.
+    * @param objectType
+    *            Object type.
+    * @param index
+    *            Attribute index where data is write.
+    * @param data
+    *            Data to Write.
+    * @param parameters
+    *            Selective access parameters.
+    * @param writer
+    *             Generated write frames are added here.
+    * Returns error status.
+    */
+    int Write(
+        CGXDLMSVariant& name,
+        DLMS_OBJECT_TYPE objectType,
+        int index,
+        CGXByteBuffer& data,
+        CGXByteBuffer* parameters,
+        CGXDLMSFrameWriter& writer);
+
     /**
     * Generates a write message.
     *
@@ -846,6 +895,28 @@ public:
         CGXByteBuffer& data,
         std::vector<CGXByteBuffer>& reply);
 
+    /**
+    * Generate Method (Action) request without copying the PDU to the frames.
+    *
+    * @param name
+    *            Method object short name or Logical Name.
+    * @param objectType
+    *            Object type.
+    * @param methodIndex
+    *            Method index.
+    * @param value
+    *            Method data.
+    * @param writer
+    *            Generated frames are added here.
+    * @return Error code.
+    */
+    int Method(
+        CGXDLMSVariant name,
+        DLMS_OBJECT_TYPE objectType,
+        int methodIndex,
+        CGXByteBuffer& data,
+        CGXDLMSFrameWriter& writer);
+
     /**
     * Read rows by entry.
     *
@@ -39,6 +39,7 @@
 #ifndef DLMS_IGNORE_COMPACT_DATA
 #include "GXDLMSObject.h"
 #include "GXDLMSCaptureObject.h"
+#include "IGXDLMSValueProducer.h"
 
 typedef enum
 {
@@ -56,7 +57,7 @@ typedef enum
 Online help:
 http://www.gurux.fi/Gurux.DLMS.Objects.GXDLMSCompactData
 */
-class CGXDLMSCompactData : public CGXDLMSObject
+class CGXDLMSCompactData : public CGXDLMSObject, public IGXDLMSValueProducer
 {
     /*
     * Compact buffer
@@ -167,6 +168,14 @@ public:
 
     // Set value of given attribute.
     int SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e);
+
+    // Serialize next part of the compact buffer.
+    int Produce(
+        CGXDLMSSettings& settings,
+        CGXDLMSValueEventArg& e,
+        unsigned long size,
+        CGXByteBuffer& data,
+        bool& completed);
 };
 #endif //DLMS_IGNORE_COMPACT_DATA
 #endif //GXDLMSCOMPACT_DATA_H
\ No newline at end of file
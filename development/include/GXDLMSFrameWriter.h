@@ -0,0 +1,195 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#ifndef GXDLMSFRAMEWRITER_H
+#define GXDLMSFRAMEWRITER_H
+
+#include <vector>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/uio.h>
+#endif
+#include "GXBytebuffer.h"
+
+/**
+ * HDLC or wrapper frames that are not copied to own buffers.
+ *
+ * Frame header and trailer are stored to the writer and the payload
+ * points to the PDU where it was generated. Each frame is a list of
+ * segments that can be sent with writev, sendmsg or WSASend.
+ * Buffers are reused after Clear so the writer should be kept alive
+ * between requests.
+ */
+class CGXDLMSFrameWriter
+{
+    friend class CGXDLMS;
+private:
+    /**
+     * Segment of the frame.
+     */
+    struct CGXSegment
+    {
+        /**
+         * PDU index or -1 if segment is in the header buffer.
+         */
+        long m_Source;
+        unsigned long m_Offset;
+        unsigned long m_Size;
+    };
+
+    /**
+     * Generated PDUs. Pointers are used so buffers are not copied
+     * when the vector grows.
+     */
+    std::vector<CGXByteBuffer*> m_Pdus;
+
+    /**
+     * Amount of used PDUs.
+     */
+    unsigned long m_PduCount;
+
+    /**
+     * Frame headers and trailers.
+     */
+    CGXByteBuffer m_Headers;
+
+    /**
+     * Segments of all frames.
+     */
+    std::vector<CGXSegment> m_Segments;
+
+    /**
+     * Index of the first segment of each frame.
+     */
+    std::vector<unsigned long> m_Frames;
+
+    /**
+     * Get next empty PDU buffer.
+     *
+     * @return PDU index.
+     */
+    long NewPdu();
+
+    /**
+     * Start new frame.
+     */
+    void NewFrame();
+
+    /**
+     * Add segment to the current frame.
+     *
+     * @param source
+     *            PDU index or -1 for the header buffer.
+     * @param offset
+     *            Offset of the segment.
+     * @param size
+     *            Size of the segment.
+     */
+    void AddSegment(long source, unsigned long offset, unsigned long size);
+
+public:
+    /**
+     * Constructor.
+     */
+    CGXDLMSFrameWriter();
+
+    /**
+     * Destructor.
+     */
+    ~CGXDLMSFrameWriter();
+
+    /**
+     * Remove all frames. Allocated buffers are kept for reuse.
+     */
+    void Clear();
+
+    /**
+     * @return Amount of frames.
+     */
+    unsigned long GetCount();
+
+    /**
+     * @param index
+     *            Frame index.
+     * @return Amount of segments in the frame.
+     */
+    unsigned long GetSegmentCount(unsigned long index);
+
+    /**
+     * @param index
+     *            Frame index.
+     * @return Size of the frame in bytes.
+     */
+    unsigned long GetSize(unsigned long index);
+
+    /**
+     * Get segment of the frame.
+     *
+     * @param index
+     *            Frame index.
+     * @param segment
+     *            Segment index.
+     * @param size
+     *            Size of the segment.
+     * @return Segment data. Data is valid until writer is changed.
+     */
+    const unsigned char* GetSegment(
+        unsigned long index,
+        unsigned long segment,
+        unsigned long& size);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    /**
+     * Get frame segments for writev or sendmsg.
+     *
+     * @param index
+     *            Frame index.
+     * @param vec
+     *            Segments. Size must be at least GetSegmentCount.
+     * @return Amount of segments.
+     */
+    int GetFrame(unsigned long index, struct iovec* vec);
+#endif
+
+    /**
+     * Copy frame to the buffer.
+     *
+     * @param index
+     *            Frame index.
+     * @param frame
+     *            Frame data.
+     * @return Error code.
+     */
+    int GetFrame(unsigned long index, CGXByteBuffer& frame);
+};
+#endif //GXDLMSFRAMEWRITER_H
@@ -41,6 +41,7 @@
 
 #include "GXDLMSObject.h"
 #include "GXDLMSImageActivateInfo.h"
+#include "GXDLMSFrameWriter.h"
 
 /**
 Online help:
@@ -111,6 +112,10 @@ public:
     // Move image to the meter.
     int ImageBlockTransfer(CGXDLMSClient* client, CGXByteBuffer& image, unsigned long& imageBlockCount, std::vector<CGXByteBuffer>& reply);
 
+    // Move image to the meter. Image blocks are not copied to each frame.
+    // Frames of all blocks are added to the writer.
+    int ImageBlockTransfer(CGXDLMSClient* client, CGXByteBuffer& image, unsigned long& imageBlockCount, CGXDLMSFrameWriter& writer);
+
     // Verify image.
     int ImageVerify(CGXDLMSClient* client, std::vector<CGXByteBuffer>& reply);
 
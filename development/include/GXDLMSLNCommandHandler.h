@@ -103,6 +103,10 @@ public:
     *
     * @param data
     *            Received data.
+    * @param streaming
+    *            Is block sent with general block transfer.
+    * @param moreBlocks
+    *            Are there more blocks in the GBT window after this block.
     */
     static int GetRequestNextDataBlock(
         CGXDLMSSettings& settings,
@@ -112,6 +116,7 @@ public:
         CGXByteBuffer* replyData,
         CGXDLMSTranslatorStructure* xml,
         bool streaming,
+        bool moreBlocks,
         unsigned char cipheredCommand);
 
     /**
@@ -59,6 +59,11 @@ private:
      */
     CGXByteBuffer m_Data;
 
+    /**
+     * Size of the values that are serialized in this transaction.
+     */
+    unsigned long m_Size;
+
 public:
 
     /**
@@ -71,9 +76,9 @@ public:
     CGXDLMSLongTransaction(CGXDLMSValueEventCollection& targets,
                            DLMS_COMMAND command, CGXByteBuffer& data)
     {
-        m_Targets.insert(m_Targets.end(), targets.begin(), targets.end());
-        targets.clear();
+        m_Targets.Move(targets);
         m_Command = command;
+        m_Size = 0;
         m_Data.Set(&data, data.GetPosition());
     }
 
@@ -87,6 +92,7 @@ public:
     CGXDLMSLongTransaction(DLMS_COMMAND command, CGXByteBuffer& data)
     {
         m_Command = command;
+        m_Size = 0;
         m_Data.Set(&data, data.GetPosition());
     }
 
@@ -114,6 +120,38 @@ public:
         return m_Data;
     }
 
+    /**
+     * @return Size of the values that are serialized in this transaction.
+     */
+    unsigned long GetSize()
+    {
+        return m_Size;
+    }
+
+    /**
+     * @param value
+     *            Size of the values that are serialized in this transaction.
+     */
+    void SetSize(unsigned long value)
+    {
+        m_Size = value;
+    }
+
+    /**
+     * @return Is there a target that has not produced the whole value.
+     */
+    bool IsProducing()
+    {
+        for (std::vector<CGXDLMSValueEventArg*>::iterator it = m_Targets.begin(); it != m_Targets.end(); ++it)
+        {
+            if ((*it)->GetProducer() != NULL)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * @param value
      *            New data.
@@ -37,6 +37,8 @@
 
 #include "GXBytebuffer.h"
 
+//This class is used to handle MD5.
+//Data can be hashed at once with Encrypt or in parts with Update and Final.
 class CGXDLMSMD5
 {
 private:
@@ -57,11 +59,33 @@ private:
 #define S42 10
 #define S43 15
 #define S44 21
+    uint32_t m_State[4];
+    //Amount of hashed bytes.
+    uint64_t m_Length;
+    //Bytes that don't fill a whole block yet.
+    unsigned char m_Buffer[64];
+
     static void Encode(unsigned char * output, unsigned int *input, unsigned int len);
-    static void Transform(unsigned char* block, unsigned int *state);
-    static int Update(unsigned char* data, unsigned int len, unsigned char* buffer, unsigned int* count, unsigned int* state);
+    static void Transform(const unsigned char* block, unsigned int *state);
 
 public:
+    /*Constructor.*/
+    CGXDLMSMD5();
+
+    /*Start a new hash.*/
+    void Init();
+
+    /*Add data to the hash.*/
+    void Update(const unsigned char* data, unsigned long size);
+
+    /*Add data from the buffer position to the end of the buffer.
+    Buffer position is not changed.*/
+    void Update(CGXByteBuffer& data);
+
+    /*Get the hash. A new hash is started after this.*/
+    int Final(CGXByteBuffer& digest);
+
+    /*Count hash for the given data.*/
     static int Encrypt(CGXByteBuffer& data, CGXByteBuffer& crypted);
 };
-#endif //GXDLMSMD5_H
\ No newline at end of file
+#endif //GXDLMSMD5_H
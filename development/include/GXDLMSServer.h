@@ -40,6 +40,7 @@
 #include "GXReplyData.h"
 #include "GXDLMSSettings.h"
 #include "GXSNInfo.h"
+#include "GXSNIndex.h"
 #include "GXDLMSSNParameters.h"
 #include "GXDLMSLNParameters.h"
 #include "GXDLMSConnectionEventArgs.h"
@@ -84,11 +85,37 @@ private:
      */
     CGXDLMSLongTransaction* m_Transaction;
 
+    /**
+     * GBT blocks that are sent but not acknowledged by the client.
+     * Lost blocks are sent again from here.
+     */
+    std::vector<CGXByteBuffer> m_GbtBlocks;
+
+    /**
+     * Index of the next GBT block that is sent again.
+     */
+    unsigned long m_GbtResend;
+
+    /**
+     * Ciphered command of the GBT blocks that are streamed.
+     */
+    unsigned char m_GbtCipheredCommand;
+
     /**
      * Is server initialized.
      */
     bool m_Initialized;
 
+    /**
+     * Short name ranges of the objects.
+     */
+    CGXSNIndex m_ShortNameIndex;
+
+    /**
+     * Value event arguments that are reused between the requests.
+     */
+    CGXDLMSValueEventPool m_EventPool;
+
     /**
     * Parse SNRM Request. If server do not accept client empty byte array is
     * returned.
@@ -145,17 +172,28 @@ private:
         CGXDLMSConnectionEventArgs& connectionInfo);
 
     /**
-    * Count how many rows can fit to one PDU.
+    * Count how many rows are needed to fill the PDU. Size of the rows
+    * that are already serialized is used when it's known. Otherwise size
+    * of the row is counted from the data types of the capture objects.
     *
     * @param pg
     *            Read profile generic.
-    * @return Rows to fit one PDU.
+    * @param rows
+    *            Amount of serialized rows.
+    * @param size
+    *            Size of the serialized rows in bytes.
+    * @param available
+    *            Free space in the PDU.
+    * @return Rows to fill the PDU.
     */
     unsigned short GetRowsToPdu(
-        CGXDLMSProfileGeneric* pg);
+        CGXDLMSProfileGeneric* pg,
+        unsigned long rows,
+        unsigned long size,
+        unsigned long available);
 
     /**
-    * Update short names.
+    * Update short names and the short name index.
     *
     * @param force
     *            Force update.
@@ -178,6 +216,25 @@ private:
         unsigned char index,
         CGXByteBuffer& buff);
 
+    /**
+    * Client acknowledges GBT blocks. Acknowledged blocks are removed
+    * and the blocks after the acknowledged block are sent again.
+    *
+    * @param sr
+    *            Server reply.
+    * @param bc
+    *            Block control of the client.
+    * @param blockNumber
+    *            Block number of the client.
+    * @param blockNumberAck
+    *            Last block that client has received.
+    */
+    void AcknowledgeBlocks(
+        CGXServerReply& sr,
+        unsigned char bc,
+        unsigned short blockNumber,
+        unsigned short blockNumberAck);
+
     /**
     * Handles GBT.
     *
@@ -363,6 +420,7 @@ protected:
 
     /**
     * Update short names.
+    * Call this if short names are changed after the server is initialized.
     */
     int UpdateShortNames();
 
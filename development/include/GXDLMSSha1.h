@@ -38,14 +38,36 @@
 #include "GXBytebuffer.h"
 
 //This class is used to handle SHA-1.
+//Data can be hashed at once with Encrypt or in parts with Update and Final.
 class CGXDLMSSha1
 {
 private:
-    static void Transform(unsigned long *block, unsigned int *digest, unsigned int *transforms);
-    static void Update(CGXByteBuffer& data, unsigned int *digest, unsigned int *transforms);
-    static int Final(CGXByteBuffer& data, unsigned int *digest, unsigned int *transforms, CGXByteBuffer& reply);
+    uint32_t m_State[5];
+    //Amount of hashed bytes.
+    uint64_t m_Length;
+    //Bytes that don't fill a whole block yet.
+    unsigned char m_Buffer[64];
+
+    static void Transform(uint32_t *digest, const unsigned char* data, unsigned long blocks);
 
 public:
+    /*Constructor.*/
+    CGXDLMSSha1();
+
+    /*Start a new hash.*/
+    void Init();
+
+    /*Add data to the hash.*/
+    void Update(const unsigned char* data, unsigned long size);
+
+    /*Add data from the buffer position to the end of the buffer.
+    Buffer position is not changed.*/
+    void Update(CGXByteBuffer& data);
+
+    /*Get the hash. A new hash is started after this.*/
+    int Final(CGXByteBuffer& digest);
+
+    /*Count hash for the given data.*/
     static int Encrypt(CGXByteBuffer& data, CGXByteBuffer& crypted);
 };
-#endif //GXDLMSSHA1_H
\ No newline at end of file
+#endif //GXDLMSSHA1_H
@@ -35,19 +35,50 @@
 #ifndef GXDLMSSHA256_H
 #define GXDLMSSHA256_H
 
+#include <vector>
 #include "GXBytebuffer.h"
 
 //This class is used to handle SHA-256.
+//Data can be hashed at once with Hash or in parts with Update and Final.
 class CGXDLMSSha256
 {
 private:
-    static void Transform(uint32_t *h, 
-        const unsigned char *message, 
-        uint32_t messageLength);
-       
+    uint32_t m_State[8];
+    //Amount of hashed bytes.
+    uint64_t m_Length;
+    //Bytes that don't fill a whole block yet.
+    unsigned char m_Buffer[64];
+
+    static void Transform(uint32_t *h,
+        const unsigned char *message,
+        unsigned long blocks);
+
 public:
+    /*Constructor.*/
+    CGXDLMSSha256();
+
+    /*Start a new hash.*/
+    void Init();
+
+    /*Add data to the hash.*/
+    void Update(const unsigned char* data,
+        unsigned long size);
+
+    /*Add data from the buffer position to the end of the buffer.
+    Buffer position is not changed.*/
+    void Update(CGXByteBuffer& data);
+
+    /*Get the hash. A new hash is started after this.*/
+    int Final(CGXByteBuffer& digest);
+
     /*Count hash for the given data.*/
     static int Hash(CGXByteBuffer& data,
         CGXByteBuffer& crypted);
+
+    /*Count hashes for several buffers at once.
+    Four buffers are hashed in parallel with SSE2 when SHA extensions are not available.
+    This is used to verify many HLS responses at once.*/
+    static int Hash(std::vector<CGXByteBuffer*>& data,
+        std::vector<CGXByteBuffer>& digests);
 };
-#endif //GXDLMSSHA256_H
\ No newline at end of file
+#endif //GXDLMSSHA256_H
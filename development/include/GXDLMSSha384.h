@@ -38,15 +38,39 @@
 #include "GXBytebuffer.h"
 
 //This class is used to handle SHA-384.
+//Data can be hashed at once with Hash or in parts with Update and Final.
 class CGXDLMSSha384
 {
 private:
-    static void Transform(uint64_t* h, 
-        const unsigned char* message, 
-        unsigned int messageLength);
+    uint64_t m_State[8];
+    //Amount of hashed bytes.
+    uint64_t m_Length;
+    //Bytes that don't fill a whole block yet.
+    unsigned char m_Buffer[128];
+
+    static void Transform(uint64_t* h,
+        const unsigned char* message,
+        unsigned long blocks);
 public:
+    /*Constructor.*/
+    CGXDLMSSha384();
+
+    /*Start a new hash.*/
+    void Init();
+
+    /*Add data to the hash.*/
+    void Update(const unsigned char* data,
+        unsigned long size);
+
+    /*Add data from the buffer position to the end of the buffer.
+    Buffer position is not changed.*/
+    void Update(CGXByteBuffer& data);
+
+    /*Get the hash. A new hash is started after this.*/
+    int Final(CGXByteBuffer& digest);
+
     /*Count hash for the given data.*/
     static int Hash(CGXByteBuffer& data,
         CGXByteBuffer& crypted);
 };
-#endif //GXDLMSSHA384_H
\ No newline at end of file
+#endif //GXDLMSSHA384_H
@@ -0,0 +1,65 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXDLMSSHANI_H
+#define GXDLMSSHANI_H
+
+#include "GXBytebuffer.h"
+
+//This class is used to count SHA-1 and SHA-256 with x86 SHA extensions.
+//Support is detected when the application is started.
+//Define DLMS_IGNORE_SHA_NI to leave SHA extensions out of the build.
+class CGXDLMSShaNi
+{
+public:
+    /*Returns true if SHA extensions are supported and enabled.*/
+    static bool IsSupported();
+
+    /*Enable or disable SHA extensions.
+    They are enabled by default when the processor supports them.
+    This is used to measure and test the portable implementation.*/
+    static void SetEnabled(bool value);
+
+    /*Hash whole 64 byte blocks with SHA-256.*/
+    static void Sha256(uint32_t* state,
+        const unsigned char* data,
+        unsigned long blocks);
+
+    /*Hash whole 64 byte blocks with SHA-1.*/
+    static void Sha1(uint32_t* state,
+        const unsigned char* data,
+        unsigned long blocks);
+};
+#endif //GXDLMSSHANI_H
@@ -45,6 +45,7 @@ class CGXDLMSClient;
 class CGXDLMSNotify;
 class CGXDLMSSettings;
 class CGXDLMSAssociationLogicalName;
+struct IGXDLMSValueProducer;
 
 class CGXDLMSValueEventArg
 {
@@ -56,6 +57,8 @@ class CGXDLMSValueEventArg
     friend class CGXDLMSAssociationShortName;
     friend class CGXDLMSLNCommandHandler;
     friend class CGXDLMSSNCommandHandler;
+    friend class CGXDLMSValueEventPool;
+    friend class CGXDLMSValueEventCollection;
 private:
     /**
     * CGXDLMSVariant value.
@@ -130,6 +133,16 @@ private:
     */
     unsigned int m_InvokeId;
 
+    /**
+    * Producer that serializes the value in parts.
+    */
+    IGXDLMSValueProducer* m_Producer;
+
+    /**
+    * Position of the producer.
+    */
+    unsigned long m_ProducerPosition;
+
     void Init(
         CGXDLMSServer* server,
         CGXDLMSObject* target,
@@ -355,5 +368,30 @@ public:
     * @return Received invoke ID.
     */
     unsigned int GetInvokeId();
+
+    /**
+    * @return Producer that serializes the value in parts.
+    */
+    IGXDLMSValueProducer* GetProducer();
+
+    /**
+    * Large values can be read in blocks without serializing the whole
+    * value. Producer can be set in PreRead.
+    *
+    * @param value
+    *            Producer that serializes the value in parts.
+    */
+    void SetProducer(IGXDLMSValueProducer* value);
+
+    /**
+    * @return Position of the producer.
+    */
+    unsigned long GetProducerPosition();
+
+    /**
+    * @param value
+    *            Position of the producer.
+    */
+    void SetProducerPosition(unsigned long value);
 };
 #endif //GXDLMSVALUEEVENTARGS_H
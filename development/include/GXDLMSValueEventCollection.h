@@ -36,19 +36,129 @@
 #define GXDLMSVALUEEVENT_COLLECTION_H
 
 #include "GXDLMSValueEventArg.h"
-
+#include "GXDLMSValueEventPool.h"
 
 class CGXDLMSValueEventCollection : public std::vector<CGXDLMSValueEventArg*>
 {
+private:
+    /**
+    * Pool where arguments are returned. Arguments are deleted if not set.
+    */
+    CGXDLMSValueEventPool* m_Pool;
 public:
+    /**
+    * Constructor.
+    */
+    CGXDLMSValueEventCollection() : m_Pool(NULL)
+    {
+    }
+
+    /**
+    * Constructor.
+    *
+    * @param pool
+    *            Pool where arguments and list buffer are taken.
+    */
+    CGXDLMSValueEventCollection(CGXDLMSValueEventPool* pool) : m_Pool(pool)
+    {
+        if (pool != NULL)
+        {
+            pool->TakeList(*this);
+        }
+    }
+
     /**
     * Destructor.
     */
     ~CGXDLMSValueEventCollection()
     {
-        for(std::vector<CGXDLMSValueEventArg*>::iterator it = begin(); it != end(); ++it)
+        Clear();
+        if (m_Pool != NULL)
+        {
+            m_Pool->ReturnList(*this);
+        }
+    }
+
+    /**
+    * @return Pool where arguments are returned.
+    */
+    CGXDLMSValueEventPool* GetPool()
+    {
+        return m_Pool;
+    }
+
+    /**
+    * Add new argument.
+    *
+    * @param server
+    *            DLMS server.
+    * @param target
+    *            Event target.
+    * @param index
+    *            Event index.
+    * @param selector
+    *            Optional read event selector.
+    * @param parameters
+    *            Optional parameters.
+    * @return Added argument.
+    */
+    CGXDLMSValueEventArg* Add(
+        CGXDLMSServer* server,
+        CGXDLMSObject* target,
+        int index,
+        int selector = 0,
+        CGXDLMSVariant* parameters = NULL)
+    {
+        CGXDLMSValueEventArg* e;
+        if (m_Pool != NULL)
+        {
+            e = m_Pool->Acquire(server, target, index, selector, parameters);
+        }
+        else if (parameters != NULL)
+        {
+            e = new CGXDLMSValueEventArg(server, target, index, selector, *parameters);
+        }
+        else
+        {
+            e = new CGXDLMSValueEventArg(server, target, index);
+            e->m_Selector = selector;
+        }
+        push_back(e);
+        return e;
+    }
+
+    /**
+    * Move arguments from the other collection. Arguments are returned
+    * to the pool of the other collection.
+    *
+    * @param value
+    *            Source collection. It's empty after this.
+    */
+    void Move(CGXDLMSValueEventCollection& value)
+    {
+        if (m_Pool == NULL)
+        {
+            m_Pool = value.m_Pool;
+        }
+        insert(end(), value.begin(), value.end());
+        value.clear();
+    }
+
+    /**
+    * Release all arguments.
+    */
+    void Clear()
+    {
+        for (std::vector<CGXDLMSValueEventArg*>::iterator it = begin(); it != end(); ++it)
         {
-            delete *it;
+            if (m_Pool != NULL)
+            {
+                m_Pool->Release(*it);
+            }
+            else
+            {
+                delete *it;
+            }
         }
         clear();
     }
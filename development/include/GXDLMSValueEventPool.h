@@ -0,0 +1,139 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXDLMSVALUEEVENTPOOL_H
+#define GXDLMSVALUEEVENTPOOL_H
+
+#include <vector>
+#include "GXDLMSValueEventArg.h"
+
+/**
+ * Pool of value event arguments.
+ *
+ * Server keeps released arguments and list buffers and reuses them
+ * with the next request. New arguments are allocated only when a
+ * request handles more attributes than any request before it.
+ */
+class CGXDLMSValueEventPool
+{
+private:
+    /**
+     * Released arguments.
+     */
+    std::vector<CGXDLMSValueEventArg*> m_Args;
+
+    /**
+     * Released list buffers.
+     */
+    std::vector<std::vector<CGXDLMSValueEventArg*> > m_Lists;
+
+    /**
+     * Amount of arguments allocated from the heap.
+     */
+    unsigned long m_Allocated;
+
+public:
+    /**
+     * Constructor.
+     */
+    CGXDLMSValueEventPool();
+
+    /**
+     * Destructor.
+     */
+    ~CGXDLMSValueEventPool();
+
+    /**
+     * Get argument from the pool.
+     *
+     * @param server
+     *            DLMS server.
+     * @param target
+     *            Event target.
+     * @param index
+     *            Event index.
+     * @param selector
+     *            Optional read event selector.
+     * @param parameters
+     *            Optional parameters.
+     * @return Initialized argument.
+     */
+    CGXDLMSValueEventArg* Acquire(
+        CGXDLMSServer* server,
+        CGXDLMSObject* target,
+        int index,
+        int selector,
+        CGXDLMSVariant* parameters);
+
+    /**
+     * Return argument to the pool.
+     *
+     * @param value
+     *            Argument to release.
+     */
+    void Release(CGXDLMSValueEventArg* value);
+
+    /**
+     * Swap released list buffer to the given empty list.
+     *
+     * @param list
+     *            List where buffer is taken.
+     */
+    void TakeList(std::vector<CGXDLMSValueEventArg*>& list);
+
+    /**
+     * Return list buffer to the pool. List is empty after this.
+     *
+     * @param list
+     *            List where buffer is returned.
+     */
+    void ReturnList(std::vector<CGXDLMSValueEventArg*>& list);
+
+    /**
+     * @return Amount of arguments allocated from the heap.
+     */
+    unsigned long GetAllocated();
+
+    /**
+     * @return Amount of released arguments waiting reuse.
+     */
+    unsigned long GetSize();
+
+    /**
+     * Free all released arguments and list buffers.
+     */
+    void Clear();
+};
+#endif //GXDLMSVALUEEVENTPOOL_H
@@ -66,6 +66,19 @@ class CGXEcdsa
     static int GetRandomNumber(CGXBigInteger& N,
         CGXByteBuffer& value);
 
+    /**
+     Verify that signature matches the data.
+
+     publicKey Parsed public key point or NULL if public key is used.
+     signature Generated signature.
+     data Data to valuate.
+     Returns error code.
+    */
+    int Verify(CGXEccPoint* publicKey,
+        CGXByteBuffer& signature,
+        CGXByteBuffer& data,
+        bool& value);
+
 public:
     /**
      Constructor.
@@ -134,6 +147,20 @@ public:
         CGXByteBuffer& data,
         bool& value);
 
+    /**
+     Verify that signature matches the data using already parsed
+     public key point. Scheme is taken from the public key of the constructor.
+
+     publicKey Public key point.
+     signature Generated signature.
+     data Data to valuate.
+     Returns error code.
+    */
+    int Verify(CGXEccPoint& publicKey,
+        CGXByteBuffer& signature,
+        CGXByteBuffer& data,
+        bool& value);
+
     /**
      Check that this is correct key.
      This method can be used to verify that 
@@ -0,0 +1,324 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXFIXEDCURVE_H
+#define GXFIXEDCURVE_H
+
+#include "GXFixedInteger.h"
+#include "GXCurve.h"
+
+/**
+ * Point of the curve in Jacobian coordinates.
+ * Coordinates are in Montgomery form. Z is zero for the point at infinity.
+ */
+template <uint16_t BITS>
+class CGXJacobianPoint
+{
+public:
+    CGXFixedInteger<BITS> X;
+    CGXFixedInteger<BITS> Y;
+    CGXFixedInteger<BITS> Z;
+
+    /**
+     * Copy point if mask is all ones.
+     */
+    void Select(const CGXJacobianPoint& value, uint32_t mask)
+    {
+        X.Select(value.X, mask);
+        Y.Select(value.Y, mask);
+        Z.Select(value.Z, mask);
+    }
+
+    /**
+     * Swap points if mask is all ones.
+     */
+    static void Swap(CGXJacobianPoint& a, CGXJacobianPoint& b, uint32_t mask)
+    {
+        CGXFixedInteger<BITS>::Swap(a.X, b.X, mask);
+        CGXFixedInteger<BITS>::Swap(a.Y, b.Y, mask);
+        CGXFixedInteger<BITS>::Swap(a.Z, b.Z, mask);
+    }
+};
+
+/**
+ * Elliptic curve arithmetic with fixed size integers.
+ *
+ * Field values are handled with Montgomery multiplication and the order of
+ * the curve with Barrett reduction. Scalar multiplication is a Montgomery
+ * ladder and runs in constant time.
+ */
+template <uint16_t BITS>
+class CGXFixedCurve
+{
+public:
+    typedef CGXFixedInteger<BITS> VALUE;
+    typedef CGXJacobianPoint<BITS> POINT;
+
+    /**
+     * Arithmetic modulo p.
+     */
+    CGXMontgomery<BITS> m_Field;
+
+    /**
+     * Arithmetic modulo n.
+     */
+    CGXBarrett<BITS> m_Order;
+
+    /**
+     * Curve a value in Montgomery form.
+     */
+    VALUE m_A;
+
+    /**
+     * Curve b value in Montgomery form.
+     */
+    VALUE m_B;
+
+    /**
+     * Base point G.
+     */
+    POINT m_G;
+
+    /**
+     * Initialize from the curve.
+     */
+    int Init(CGXCurve& curve)
+    {
+        int ret;
+        VALUE p, n, a, b, x, y;
+        CGXBigInteger tmp = curve.GetB();
+        if ((ret = p.FromBigInteger(curve.GetP())) != 0 ||
+            (ret = n.FromBigInteger(curve.GetN())) != 0 ||
+            (ret = a.FromBigInteger(curve.GetA())) != 0 ||
+            (ret = b.FromBigInteger(tmp)) != 0 ||
+            (ret = x.FromBigInteger(curve.GetG().X)) != 0 ||
+            (ret = y.FromBigInteger(curve.GetG().Y)) != 0)
+        {
+            return ret;
+        }
+        m_Field.Init(p);
+        m_Order.Init(n);
+        m_Field.ToMontgomery(m_A, a);
+        m_Field.ToMontgomery(m_B, b);
+        FromAffine(m_G, x, y);
+        return 0;
+    }
+
+    /**
+     * Convert affine coordinates to Jacobian point.
+     */
+    void FromAffine(POINT& ret, const VALUE& x, const VALUE& y) const
+    {
+        m_Field.ToMontgomery(ret.X, x);
+        m_Field.ToMontgomery(ret.Y, y);
+        ret.Z = m_Field.m_One;
+    }
+
+    /**
+     * Convert Jacobian point to affine coordinates.
+     *
+     * @return Error code. Point at infinity can't be converted.
+     */
+    int ToAffine(VALUE& x, VALUE& y, const POINT& point) const
+    {
+        VALUE zinv, zinv2;
+        if (point.Z.IsZero())
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+        m_Field.Inverse(zinv, point.Z);
+        m_Field.Square(zinv2, zinv);
+        m_Field.Multiply(x, point.X, zinv2);
+        m_Field.Multiply(zinv2, zinv2, zinv);
+        m_Field.Multiply(y, point.Y, zinv2);
+        m_Field.FromMontgomery(x, x);
+        m_Field.FromMontgomery(y, y);
+        return 0;
+    }
+
+    /**
+     * ret = 2 * point. Point at infinity stays at infinity.
+     */
+    void Double(POINT& ret, const POINT& point) const
+    {
+        VALUE xx, yy, yyyy, zz, s, m, tmp;
+        m_Field.Square(xx, point.X);
+        m_Field.Square(yy, point.Y);
+        m_Field.Square(yyyy, yy);
+        m_Field.Square(zz, point.Z);
+        //s = 4 * x * yy
+        m_Field.Multiply(s, point.X, yy);
+        m_Field.Add(s, s, s);
+        m_Field.Add(s, s, s);
+        //m = 3 * xx + a * zz^2
+        m_Field.Add(m, xx, xx);
+        m_Field.Add(m, m, xx);
+        m_Field.Square(tmp, zz);
+        m_Field.Multiply(tmp, tmp, m_A);
+        m_Field.Add(m, m, tmp);
+        //z3 = 2 * y * z
+        m_Field.Multiply(ret.Z, point.Y, point.Z);
+        m_Field.Add(ret.Z, ret.Z, ret.Z);
+        //x3 = m^2 - 2 * s
+        m_Field.Square(tmp, m);
+        m_Field.Sub(tmp, tmp, s);
+        m_Field.Sub(ret.X, tmp, s);
+        //y3 = m * (s - x3) - 8 * yyyy
+        m_Field.Sub(tmp, s, ret.X);
+        m_Field.Multiply(tmp, m, tmp);
+        m_Field.Add(yyyy, yyyy, yyyy);
+        m_Field.Add(yyyy, yyyy, yyyy);
+        m_Field.Add(yyyy, yyyy, yyyy);
+        m_Field.Sub(ret.Y, tmp, yyyy);
+    }
+
+    /**
+     * ret = p1 + p2. Points at infinity are handled in constant time.
+     * Points must not be equal.
+     *
+     * @return All ones if points are equal and result is not valid.
+     */
+    uint32_t Add(POINT& ret, const POINT& p1, const POINT& p2) const
+    {
+        VALUE z1z1, z2z2, u1, u2, s1, s2, h, r, hh, hhh, v, tmp;
+        POINT sum;
+        m_Field.Square(z1z1, p1.Z);
+        m_Field.Square(z2z2, p2.Z);
+        m_Field.Multiply(u1, p1.X, z2z2);
+        m_Field.Multiply(u2, p2.X, z1z1);
+        m_Field.Multiply(s1, p1.Y, p2.Z);
+        m_Field.Multiply(s1, s1, z2z2);
+        m_Field.Multiply(s2, p2.Y, p1.Z);
+        m_Field.Multiply(s2, s2, z1z1);
+        m_Field.Sub(h, u2, u1);
+        m_Field.Sub(r, s2, s1);
+        m_Field.Square(hh, h);
+        m_Field.Multiply(hhh, h, hh);
+        m_Field.Multiply(v, u1, hh);
+        //x3 = r^2 - hhh - 2 * v
+        m_Field.Square(tmp, r);
+        m_Field.Sub(tmp, tmp, hhh);
+        m_Field.Sub(tmp, tmp, v);
+        m_Field.Sub(sum.X, tmp, v);
+        //y3 = r * (v - x3) - s1 * hhh
+        m_Field.Sub(tmp, v, sum.X);
+        m_Field.Multiply(tmp, r, tmp);
+        m_Field.Multiply(s1, s1, hhh);
+        m_Field.Sub(sum.Y, tmp, s1);
+        //z3 = z1 * z2 * h
+        m_Field.Multiply(tmp, p1.Z, p2.Z);
+        m_Field.Multiply(sum.Z, tmp, h);
+        uint32_t inf1 = p1.Z.ZeroMask(), inf2 = p2.Z.ZeroMask();
+        sum.Select(p2, inf1);
+        sum.Select(p1, inf2 & ~inf1);
+        ret = sum;
+        return h.ZeroMask() & r.ZeroMask() & ~inf1 & ~inf2;
+    }
+
+    /**
+     * ret = scalar * point. Runs in constant time.
+     */
+    void Multiply(POINT& ret, const POINT& point, const VALUE& scalar) const
+    {
+        POINT r0, r1 = point;
+        r0.X = m_Field.m_One;
+        r0.Y = m_Field.m_One;
+        r0.Z.Clear();
+        for (uint16_t pos = BITS; pos != 0; --pos)
+        {
+            uint32_t mask = 0 - scalar.GetBit(pos - 1);
+            POINT::Swap(r0, r1, mask);
+            Add(r1, r0, r1);
+            Double(r0, r0);
+            POINT::Swap(r0, r1, mask);
+        }
+        ret = r0;
+    }
+
+    /**
+     * ret = u1 * G + u2 * q using Shamir's trick.
+     * Scalars are public and this is not constant time.
+     */
+    void Trick(POINT& ret, const VALUE& u1, const VALUE& u2, const POINT& q) const
+    {
+        POINT sum, r;
+        if (Add(sum, m_G, q) != 0)
+        {
+            Double(sum, m_G);
+        }
+        uint16_t bits1 = u1.GetUsedBits(), bits2 = u2.GetUsedBits();
+        uint16_t pos = bits1 > bits2 ? bits1 : bits2;
+        r.X = m_Field.m_One;
+        r.Y = m_Field.m_One;
+        r.Z.Clear();
+        for (; pos != 0; --pos)
+        {
+            Double(r, r);
+            uint32_t b1 = u1.GetBit(pos - 1), b2 = u2.GetBit(pos - 1);
+            if (b1 != 0 || b2 != 0)
+            {
+                const POINT& p = b1 != 0 && b2 != 0 ? sum : b1 != 0 ? m_G : q;
+                if (Add(r, r, p) != 0)
+                {
+                    Double(r, p);
+                }
+            }
+        }
+        ret = r;
+    }
+
+    /**
+     * Check that affine point is on the curve.
+     */
+    bool IsOnCurve(const VALUE& x, const VALUE& y) const
+    {
+        VALUE mx, my, left, right, tmp;
+        if (x.Compare(m_Field.m_Modulus) >= 0 || y.Compare(m_Field.m_Modulus) >= 0)
+        {
+            return false;
+        }
+        m_Field.ToMontgomery(mx, x);
+        m_Field.ToMontgomery(my, y);
+        //y^2 = x^3 + a * x + b
+        m_Field.Square(left, my);
+        m_Field.Square(right, mx);
+        m_Field.Add(right, right, m_A);
+        m_Field.Multiply(right, right, mx);
+        m_Field.Add(right, right, m_B);
+        return left.Compare(right) == 0;
+    }
+};
+
+#endif //GXFIXEDCURVE_H
@@ -0,0 +1,675 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXFIXEDINTEGER_H
+#define GXFIXEDINTEGER_H
+
+#include <string.h>
+#include "GXBigInteger.h"
+
+/**
+ * Fixed size unsigned integer with stack storage.
+ *
+ * Values are kept in 32 bit words, least significant word first. Arithmetic
+ * doesn't branch on the value so it can be used with secret scalars.
+ */
+template <uint16_t BITS>
+class CGXFixedInteger
+{
+public:
+    enum
+    {
+        //Amount of 32 bit words.
+        COUNT = BITS / 32,
+        //Size in bytes.
+        SIZE = BITS / 8
+    };
+
+    /**
+     * Value, least significant word first.
+     */
+    uint32_t m_Data[COUNT];
+
+    /**
+     * Constructor.
+     */
+    CGXFixedInteger()
+    {
+        Clear();
+    }
+
+    /**
+     * Constructor.
+     */
+    CGXFixedInteger(uint32_t value)
+    {
+        Clear();
+        m_Data[0] = value;
+    }
+
+    /**
+     * Reset value to zero.
+     */
+    void Clear()
+    {
+        memset(m_Data, 0, sizeof(m_Data));
+    }
+
+    /**
+     * Set value from big endian bytes.
+     *
+     * @param data Value in MSB format.
+     * @param size Size of the value in bytes.
+     * @return Error code. Value is too big if the high bytes are not zero.
+     */
+    int FromBytes(const unsigned char* data, unsigned long size)
+    {
+        unsigned long pos;
+        Clear();
+        for (pos = 0; pos < size; ++pos)
+        {
+            unsigned long index = size - pos - 1;
+            if (index >= SIZE)
+            {
+                if (data[pos] != 0)
+                {
+                    return DLMS_ERROR_CODE_INVALID_PARAMETER;
+                }
+                continue;
+            }
+            m_Data[index / 4] |= (uint32_t)data[pos] << (8 * (index % 4));
+        }
+        return 0;
+    }
+
+    /**
+     * Get value as big endian bytes.
+     *
+     * @param data SIZE bytes buffer where value is saved in MSB format.
+     */
+    void ToBytes(unsigned char* data) const
+    {
+        for (uint16_t pos = 0; pos != SIZE; ++pos)
+        {
+            uint16_t index = SIZE - pos - 1;
+            data[pos] = (unsigned char)(m_Data[index / 4] >> (8 * (index % 4)));
+        }
+    }
+
+    /**
+     * Set value from big integer.
+     */
+    int FromBigInteger(CGXBigInteger& value)
+    {
+        CGXByteBuffer bb;
+        int ret = value.ToArray(bb, false);
+        if (ret == 0)
+        {
+            ret = FromBytes(bb.GetData(), bb.GetSize());
+        }
+        return ret;
+    }
+
+    /**
+     * Get value as big integer.
+     */
+    void ToBigInteger(CGXBigInteger& value) const
+    {
+        uint16_t count = COUNT;
+        //Leading zero words are not added.
+        while (count > 1 && m_Data[count - 1] == 0)
+        {
+            --count;
+        }
+        value = CGXBigInteger(m_Data, count);
+    }
+
+    /**
+     * this = a + b.
+     *
+     * @return Carry.
+     */
+    uint32_t Add(const CGXFixedInteger& a, const CGXFixedInteger& b)
+    {
+        uint64_t carry = 0;
+        for (uint16_t pos = 0; pos != COUNT; ++pos)
+        {
+            carry += (uint64_t)a.m_Data[pos] + b.m_Data[pos];
+            m_Data[pos] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        return (uint32_t)carry;
+    }
+
+    /**
+     * this = a - b.
+     *
+     * @return Borrow.
+     */
+    uint32_t Sub(const CGXFixedInteger& a, const CGXFixedInteger& b)
+    {
+        uint64_t borrow = 0;
+        for (uint16_t pos = 0; pos != COUNT; ++pos)
+        {
+            uint64_t tmp = (uint64_t)a.m_Data[pos] - b.m_Data[pos] - borrow;
+            m_Data[pos] = (uint32_t)tmp;
+            borrow = (tmp >> 32) & 1;
+        }
+        return (uint32_t)borrow;
+    }
+
+    /**
+     * Copy value if mask is all ones. Mask must be zero or all ones.
+     */
+    void Select(const CGXFixedInteger& value, uint32_t mask)
+    {
+        for (uint16_t pos = 0; pos != COUNT; ++pos)
+        {
+            m_Data[pos] ^= mask & (m_Data[pos] ^ value.m_Data[pos]);
+        }
+    }
+
+    /**
+     * Swap values if mask is all ones. Mask must be zero or all ones.
+     */
+    static void Swap(CGXFixedInteger& a, CGXFixedInteger& b, uint32_t mask)
+    {
+        for (uint16_t pos = 0; pos != COUNT; ++pos)
+        {
+            uint32_t tmp = mask & (a.m_Data[pos] ^ b.m_Data[pos]);
+            a.m_Data[pos] ^= tmp;
+            b.m_Data[pos] ^= tmp;
+        }
+    }
+
+    /**
+     * @return All ones if value is zero. Otherwise zero.
+     */
+    uint32_t ZeroMask() const
+    {
+        uint32_t value = 0;
+        for (uint16_t pos = 0; pos != COUNT; ++pos)
+        {
+            value |= m_Data[pos];
+        }
+        //High bit is set if value is not zero.
+        value = (value | (0 - value)) >> 31;
+        return value - 1;
+    }
+
+    /**
+     * Is value zero.
+     */
+    bool IsZero() const
+    {
+        return ZeroMask() != 0;
+    }
+
+    /**
+     * Is bit set. Bit index must be smaller than BITS.
+     */
+    uint32_t GetBit(uint16_t index) const
+    {
+        return (m_Data[index / 32] >> (index % 32)) & 1;
+    }
+
+    /**
+     * Amount of used bits. This is not constant time.
+     */
+    uint16_t GetUsedBits() const
+    {
+        for (uint16_t pos = COUNT; pos != 0; --pos)
+        {
+            uint32_t value = m_Data[pos - 1];
+            if (value != 0)
+            {
+                uint16_t bits = 32 * (pos - 1);
+                while (value != 0)
+                {
+                    ++bits;
+                    value >>= 1;
+                }
+                return bits;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Compare values. This is not constant time.
+     *
+     * @return 1 if this is bigger, -1 if smaller and 0 if values are equals.
+     */
+    int Compare(const CGXFixedInteger& value) const
+    {
+        for (uint16_t pos = COUNT; pos != 0; --pos)
+        {
+            if (m_Data[pos - 1] != value.m_Data[pos - 1])
+            {
+                return m_Data[pos - 1] > value.m_Data[pos - 1] ? 1 : -1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Full product of a and b. Product has 2 * COUNT words.
+     */
+    static void Multiply(
+        uint32_t* product,
+        const CGXFixedInteger& a,
+        const CGXFixedInteger& b)
+    {
+        uint16_t i, j;
+        memset(product, 0, 2 * COUNT * sizeof(uint32_t));
+        for (i = 0; i != COUNT; ++i)
+        {
+            uint64_t carry = 0;
+            for (j = 0; j != COUNT; ++j)
+            {
+                carry += (uint64_t)a.m_Data[j] * b.m_Data[i] + product[i + j];
+                product[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            product[i + COUNT] = (uint32_t)carry;
+        }
+    }
+};
+
+/**
+ * Modular arithmetic using Montgomery multiplication.
+ *
+ * Modulus must be odd. Values are kept in Montgomery form (a * R mod m,
+ * where R = 2^BITS). Multiplication, addition and subtraction run in
+ * constant time.
+ */
+template <uint16_t BITS>
+class CGXMontgomery
+{
+public:
+    typedef CGXFixedInteger<BITS> VALUE;
+    enum
+    {
+        COUNT = VALUE::COUNT
+    };
+
+    /**
+     * Modulus.
+     */
+    VALUE m_Modulus;
+
+    /**
+     * R^2 mod m.
+     */
+    VALUE m_R2;
+
+    /**
+     * One in Montgomery form (R mod m).
+     */
+    VALUE m_One;
+
+    /**
+     * -m^-1 mod 2^32.
+     */
+    uint32_t m_N0;
+
+    /**
+     * Initialize for the modulus.
+     *
+     * @param modulus Odd modulus.
+     */
+    void Init(const VALUE& modulus)
+    {
+        uint16_t pos;
+        m_Modulus = modulus;
+        //Newton iteration for the inverse of the lowest word.
+        uint32_t inv = 1;
+        for (pos = 0; pos != 5; ++pos)
+        {
+            inv *= 2 - modulus.m_Data[0] * inv;
+        }
+        m_N0 = 0 - inv;
+        //R mod m is counted by doubling one BITS times.
+        VALUE tmp(1);
+        for (pos = 0; pos != BITS; ++pos)
+        {
+            Add(tmp, tmp, tmp);
+        }
+        m_One = tmp;
+        for (pos = 0; pos != BITS; ++pos)
+        {
+            Add(tmp, tmp, tmp);
+        }
+        m_R2 = tmp;
+    }
+
+    /**
+     * ret = a + b mod m.
+     */
+    void Add(VALUE& ret, const VALUE& a, const VALUE& b) const
+    {
+        VALUE tmp;
+        uint32_t carry = ret.Add(a, b);
+        uint32_t borrow = tmp.Sub(ret, m_Modulus);
+        //Subtract modulus if sum overflowed or sum >= m.
+        ret.Select(tmp, 0 - (carry | (borrow ^ 1)));
+    }
+
+    /**
+     * ret = a - b mod m.
+     */
+    void Sub(VALUE& ret, const VALUE& a, const VALUE& b) const
+    {
+        VALUE tmp;
+        uint32_t borrow = ret.Sub(a, b);
+        tmp.Add(ret, m_Modulus);
+        ret.Select(tmp, 0 - borrow);
+    }
+
+    /**
+     * ret = a * b * R^-1 mod m.
+     */
+    void Multiply(VALUE& ret, const VALUE& a, const VALUE& b) const
+    {
+        uint32_t t[COUNT + 2];
+        uint16_t i, j;
+        uint64_t carry;
+        memset(t, 0, sizeof(t));
+        for (i = 0; i != COUNT; ++i)
+        {
+            carry = 0;
+            for (j = 0; j != COUNT; ++j)
+            {
+                carry += (uint64_t)a.m_Data[j] * b.m_Data[i] + t[j];
+                t[j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            carry += t[COUNT];
+            t[COUNT] = (uint32_t)carry;
+            t[COUNT + 1] = (uint32_t)(carry >> 32);
+            uint32_t m = t[0] * m_N0;
+            carry = ((uint64_t)m * m_Modulus.m_Data[0] + t[0]) >> 32;
+            for (j = 1; j != COUNT; ++j)
+            {
+                carry += (uint64_t)m * m_Modulus.m_Data[j] + t[j];
+                t[j - 1] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            carry += t[COUNT];
+            t[COUNT - 1] = (uint32_t)carry;
+            t[COUNT] = t[COUNT + 1] + (uint32_t)(carry >> 32);
+        }
+        VALUE tmp;
+        memcpy(ret.m_Data, t, sizeof(ret.m_Data));
+        uint32_t borrow = tmp.Sub(ret, m_Modulus);
+        ret.Select(tmp, 0 - (t[COUNT] | (borrow ^ 1)));
+    }
+
+    /**
+     * ret = a^2 * R^-1 mod m.
+     */
+    void Square(VALUE& ret, const VALUE& a) const
+    {
+        Multiply(ret, a, a);
+    }
+
+    /**
+     * Convert value to Montgomery form.
+     */
+    void ToMontgomery(VALUE& ret, const VALUE& a) const
+    {
+        Multiply(ret, a, m_R2);
+    }
+
+    /**
+     * Convert value from Montgomery form.
+     */
+    void FromMontgomery(VALUE& ret, const VALUE& a) const
+    {
+        VALUE one(1);
+        Multiply(ret, a, one);
+    }
+
+    /**
+     * ret = a^exponent. Values are in Montgomery form.
+     * Running time depends only on the exponent.
+     */
+    void Pow(VALUE& ret, const VALUE& a, const VALUE& exponent) const
+    {
+        VALUE result = m_One, base = a;
+        for (uint16_t pos = BITS; pos != 0; --pos)
+        {
+            Square(result, result);
+            if (exponent.GetBit(pos - 1))
+            {
+                Multiply(result, result, base);
+            }
+        }
+        ret = result;
+    }
+
+    /**
+     * ret = a^-1 mod m. Modulus must be prime. Values are in Montgomery form.
+     */
+    void Inverse(VALUE& ret, const VALUE& a) const
+    {
+        VALUE exponent, two(2);
+        exponent.Sub(m_Modulus, two);
+        Pow(ret, a, exponent);
+    }
+};
+
+/**
+ * Modular arithmetic using Barrett reduction.
+ *
+ * Used for the order n of the curve where values are not kept in
+ * Montgomery form. Reduction runs in constant time. The highest word of the
+ * modulus must not be zero.
+ */
+template <uint16_t BITS>
+class CGXBarrett
+{
+public:
+    typedef CGXFixedInteger<BITS> VALUE;
+    enum
+    {
+        COUNT = VALUE::COUNT
+    };
+
+    /**
+     * Modulus.
+     */
+    VALUE m_Modulus;
+
+    /**
+     * floor(2^(2 * BITS) / m).
+     */
+    uint32_t m_Mu[COUNT + 1];
+
+    /**
+     * Initialize for the modulus.
+     */
+    void Init(const VALUE& modulus)
+    {
+        uint32_t r[COUNT + 1], tmp[COUNT + 1];
+        int pos;
+        uint16_t i;
+        m_Modulus = modulus;
+        memset(r, 0, sizeof(r));
+        memset(m_Mu, 0, sizeof(m_Mu));
+        //Long division of 2^(2 * BITS) one bit at the time.
+        for (pos = 2 * BITS; pos >= 0; --pos)
+        {
+            uint32_t high = r[COUNT] >> 31;
+            for (i = COUNT; i != 0; --i)
+            {
+                r[i] = (r[i] << 1) | (r[i - 1] >> 31);
+            }
+            r[0] = (r[0] << 1) | (pos == 2 * BITS ? 1 : 0);
+            uint64_t borrow = 0;
+            for (i = 0; i != COUNT + 1; ++i)
+            {
+                uint64_t value = (uint64_t)r[i] - (i < COUNT ? modulus.m_Data[i] : 0) - borrow;
+                tmp[i] = (uint32_t)value;
+                borrow = (value >> 32) & 1;
+            }
+            if (high != 0 || borrow == 0)
+            {
+                memcpy(r, tmp, sizeof(r));
+                if (pos < 32 * (COUNT + 1))
+                {
+                    m_Mu[pos / 32] |= (uint32_t)1 << (pos % 32);
+                }
+            }
+        }
+    }
+
+    /**
+     * ret = value mod m.
+     *
+     * @param value 2 * COUNT words, least significant word first.
+     */
+    void Reduce(VALUE& ret, const uint32_t* value) const
+    {
+        uint32_t q2[2 * COUNT + 2], r[COUNT + 1], tmp[COUNT + 1];
+        uint16_t i, j;
+        uint64_t carry;
+        //q2 = floor(value / 2^(BITS - 32)) * mu.
+        const uint32_t* q1 = value + COUNT - 1;
+        memset(q2, 0, sizeof(q2));
+        for (i = 0; i != COUNT + 1; ++i)
+        {
+            carry = 0;
+            for (j = 0; j != COUNT + 1; ++j)
+            {
+                carry += (uint64_t)q1[j] * m_Mu[i] + q2[i + j];
+                q2[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            q2[i + COUNT + 1] = (uint32_t)carry;
+        }
+        //q3 = floor(q2 / 2^(BITS + 32)).
+        const uint32_t* q3 = q2 + COUNT + 1;
+        //r = value - q3 * m mod 2^(BITS + 32).
+        memset(tmp, 0, sizeof(tmp));
+        for (i = 0; i != COUNT + 1; ++i)
+        {
+            carry = 0;
+            for (j = 0; i + j != COUNT + 1; ++j)
+            {
+                carry += (uint64_t)q3[i] * (j < COUNT ? m_Modulus.m_Data[j] : 0) + tmp[i + j];
+                tmp[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+        }
+        carry = 0;
+        for (i = 0; i != COUNT + 1; ++i)
+        {
+            uint64_t v = (uint64_t)value[i] - tmp[i] - carry;
+            r[i] = (uint32_t)v;
+            carry = (v >> 32) & 1;
+        }
+        //Result is smaller than 3m. Subtract modulus at most twice.
+        for (j = 0; j != 2; ++j)
+        {
+            carry = 0;
+            for (i = 0; i != COUNT + 1; ++i)
+            {
+                uint64_t v = (uint64_t)r[i] - (i < COUNT ? m_Modulus.m_Data[i] : 0) - carry;
+                tmp[i] = (uint32_t)v;
+                carry = (v >> 32) & 1;
+            }
+            uint32_t mask = (uint32_t)carry - 1;
+            for (i = 0; i != COUNT + 1; ++i)
+            {
+                r[i] ^= mask & (r[i] ^ tmp[i]);
+            }
+        }
+        memcpy(ret.m_Data, r, sizeof(ret.m_Data));
+    }
+
+    /**
+     * ret = value mod m.
+     */
+    void Reduce(VALUE& ret, const VALUE& value) const
+    {
+        uint32_t tmp[2 * COUNT];
+        memcpy(tmp, value.m_Data, sizeof(value.m_Data));
+        memset(tmp + COUNT, 0, sizeof(value.m_Data));
+        Reduce(ret, tmp);
+    }
+
+    /**
+     * ret = a * b mod m.
+     */
+    void Multiply(VALUE& ret, const VALUE& a, const VALUE& b) const
+    {
+        uint32_t product[2 * COUNT];
+        VALUE::Multiply(product, a, b);
+        Reduce(ret, product);
+    }
+
+    /**
+     * ret = a + b mod m. Values must be smaller than m.
+     */
+    void Add(VALUE& ret, const VALUE& a, const VALUE& b) const
+    {
+        VALUE tmp;
+        uint32_t carry = ret.Add(a, b);
+        uint32_t borrow = tmp.Sub(ret, m_Modulus);
+        ret.Select(tmp, 0 - (carry | (borrow ^ 1)));
+    }
+
+    /**
+     * ret = a^-1 mod m. Modulus must be prime.
+     * Running time doesn't depend on the value.
+     */
+    void Inverse(VALUE& ret, const VALUE& a) const
+    {
+        VALUE exponent, two(2), result(1), base = a;
+        exponent.Sub(m_Modulus, two);
+        for (uint16_t pos = BITS; pos != 0; --pos)
+        {
+            Multiply(result, result, result);
+            if (exponent.GetBit(pos - 1))
+            {
+                Multiply(result, result, base);
+            }
+        }
+        ret = result;
+    }
+};
+
+#endif //GXFIXEDINTEGER_H
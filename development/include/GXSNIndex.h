@@ -0,0 +1,122 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#ifndef GXSNINDEX_H
+#define GXSNINDEX_H
+
+#include <vector>
+#include "GXDLMSObjectCollection.h"
+#include "GXSNInfo.h"
+
+/**
+ * Sorted table of short name ranges.
+ *
+ * Each object reserves 8 short names for every attribute and method.
+ * Ranges are kept sorted so the object of the short name is found
+ * with binary search.
+ */
+class CGXSNIndex
+{
+private:
+    /**
+     * Short name range of an attribute or method block.
+     */
+    struct CGXSNRange
+    {
+        //First short name of the range.
+        int m_Start;
+        //End of the range. Not included.
+        int m_End;
+        //Short name of the first attribute or method.
+        int m_Base;
+        //Is method range.
+        bool m_Action;
+        //COSEM object.
+        CGXDLMSObject* m_Object;
+    };
+
+    std::vector<CGXSNRange> m_Ranges;
+
+    /**
+     * Amount of objects when the table was updated.
+     */
+    size_t m_Count;
+
+    /**
+     * Add range. Parts that are already used by earlier objects are skipped.
+     */
+    static void Add(
+        std::vector<CGXSNRange>& ranges,
+        int start,
+        int end,
+        int base,
+        bool action,
+        CGXDLMSObject* target);
+
+public:
+    /**
+     * Constructor.
+     */
+    CGXSNIndex();
+
+    /**
+     * Update ranges from the objects. If ranges overlap
+     * the object that is first in the collection is used.
+     */
+    void Update(CGXDLMSObjectCollection& objects);
+
+    /**
+     * Is table updated for the objects. Objects are not compared one by one.
+     * Only the amount of objects is checked.
+     */
+    bool IsUpdated(CGXDLMSObjectCollection& objects);
+
+    /**
+     * Find object of the short name.
+     *
+     * @param sn
+     *            Short name.
+     * @param info
+     *            Found object and attribute or method index.
+     * @return True, if object is found.
+     */
+    bool Find(int sn, CGXSNInfo& info);
+
+    /**
+     * Remove all ranges.
+     */
+    void Clear();
+};
+#endif //GXSNINDEX_H
@@ -58,6 +58,20 @@ public:
         CGXBigInteger& u1,
         CGXBigInteger& u2);
 
+    /// <summary>
+    /// Count Shamir's trick using already parsed public key point.
+    /// </summary>
+    /// <param name="curve">Used curve.</param>
+    /// <param name="pub">Public key point.</param>
+    /// <param name="ret">Result.</param>
+    /// <param name="u1"></param>
+    /// <param name="u2"></param>
+    static int Trick(CGXCurve& curve,
+        CGXEccPoint& pub,
+        CGXEccPoint& ret,
+        CGXBigInteger& u1,
+        CGXBigInteger& u2);
+
     /// <summary>
     /// Add points.
     /// </summary>
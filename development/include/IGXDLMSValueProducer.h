@@ -0,0 +1,81 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#ifndef IGXDLMSVALUEPRODUCER_H
+#define IGXDLMSVALUEPRODUCER_H
+
+#include "GXBytebuffer.h"
+#include "GXDLMSValueEventArg.h"
+
+class CGXDLMSSettings;
+
+/**
+ * Value producer is used when the server reads a large attribute value
+ * in blocks. Only the next part of the value is serialized for each
+ * block, so the whole value is never kept in memory.
+ *
+ * The position of the produced value is kept in the value event
+ * argument. Producer is not owned by the server.
+ */
+struct IGXDLMSValueProducer
+{
+public:
+    virtual ~IGXDLMSValueProducer()
+    {
+    }
+
+    /**
+     * Serialize the next part of the value.
+     *
+     * @param settings
+     *            DLMS settings.
+     * @param e
+     *            Value event argument. Position tells the produced amount.
+     * @param size
+     *            Amount of bytes that is wanted. At least one item is
+     *            added even if it's bigger.
+     * @param data
+     *            Serialized data is appended here.
+     * @param completed
+     *            Is the whole value produced.
+     * @return Error code.
+     */
+    virtual int Produce(
+        CGXDLMSSettings& settings,
+        CGXDLMSValueEventArg& e,
+        unsigned long size,
+        CGXByteBuffer& data,
+        bool& completed) = 0;
+};
+#endif //IGXDLMSVALUEPRODUCER_H
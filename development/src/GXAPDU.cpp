@@ -1832,7 +1832,16 @@ int CGXAPDU::ParsePDU2(
                 CGXByteBuffer tmp;
                 tmp.Set(&buff, buff.GetPosition(), len2);
                 CGXx509Certificate cert;
-                if ((ret = CGXx509Certificate::FromByteArray(tmp, cert)) != 0)
+                if (settings.GetCipher()->GetCertificateCache() != NULL)
+                {
+                    ret = settings.GetCipher()->GetCertificateCache()->GetCertificate(
+                        settings.GetSourceSystemTitle(), tmp, cert);
+                }
+                else
+                {
+                    ret = CGXx509Certificate::FromByteArray(tmp, cert);
+                }
+                if (ret != 0)
                 {
                     return ret;
                 }
@@ -1883,7 +1892,16 @@ int CGXAPDU::ParsePDU2(
                 CGXByteBuffer tmp;
                 tmp.Set(&buff, buff.GetPosition(), len2);
                 CGXx509Certificate cert;
-                if ((ret = CGXx509Certificate::FromByteArray(tmp, cert)) != 0)
+                if (settings.GetCipher()->GetCertificateCache() != NULL)
+                {
+                    ret = settings.GetCipher()->GetCertificateCache()->GetCertificate(
+                        settings.GetSourceSystemTitle(), tmp, cert);
+                }
+                else
+                {
+                    ret = CGXx509Certificate::FromByteArray(tmp, cert);
+                }
+                if (ret != 0)
                 {
                     return ret;
                 }
@@ -0,0 +1,205 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include "../include/GXCertificateCache.h"
+#include "../include/GXEcdsa.h"
+#include "../include/GXDLMSSha256.h"
+
+CGXCertificateCache::CGXCertificateCache(size_t maxSize)
+{
+    m_MaxSize = maxSize;
+    m_Hits = 0;
+    m_Misses = 0;
+}
+
+size_t CGXCertificateCache::GetMaxSize()
+{
+    return m_MaxSize;
+}
+
+void CGXCertificateCache::SetMaxSize(size_t value)
+{
+    m_MaxSize = value;
+}
+
+unsigned long CGXCertificateCache::GetHits()
+{
+    return m_Hits;
+}
+
+unsigned long CGXCertificateCache::GetMisses()
+{
+    return m_Misses;
+}
+
+int CGXCertificateCache::GetHash(
+    const unsigned char* data,
+    unsigned long size,
+    std::string& value)
+{
+    int ret;
+    CGXByteBuffer digest;
+    CGXDLMSSha256 sha;
+    sha.Update(data, size);
+    if ((ret = sha.Final(digest)) == 0)
+    {
+        value.append((char*)digest.GetData(), digest.GetSize());
+    }
+    return ret;
+}
+
+int CGXCertificateCache::GetCertificate(
+    CGXByteBuffer& systemTitle,
+    CGXByteBuffer& data,
+    CGXx509Certificate& value)
+{
+    int ret;
+    std::string key((char*)systemTitle.GetData(), systemTitle.GetSize());
+    if ((ret = GetHash(data.GetData() + data.GetPosition(), data.Available(), key)) != 0)
+    {
+        return ret;
+    }
+    std::map<std::string, CGXx509Certificate>::iterator it = m_Certificates.find(key);
+    if (it != m_Certificates.end())
+    {
+        ++m_Hits;
+        value = it->second;
+        return 0;
+    }
+    ++m_Misses;
+    if ((ret = CGXx509Certificate::FromByteArray(data, value)) != 0)
+    {
+        return ret;
+    }
+    if (m_MaxSize != 0 && m_Certificates.size() >= m_MaxSize)
+    {
+        m_Certificates.clear();
+    }
+    m_Certificates[key] = value;
+    return 0;
+}
+
+int CGXCertificateCache::GetPoint(
+    CGXPublicKey& key,
+    CGXEccPoint& value)
+{
+    CGXByteArray& raw = key.GetRawValue();
+    if (raw.GetSize() == 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    std::string id((char*)raw.GetData(), raw.GetSize());
+    std::map<std::string, CGXEccPoint>::iterator it = m_Points.find(id);
+    if (it != m_Points.end())
+    {
+        ++m_Hits;
+        value = it->second;
+        return 0;
+    }
+    ++m_Misses;
+    CGXByteArray x = key.GetX(), y = key.GetY();
+    value.X = CGXBigInteger(x);
+    value.Y = CGXBigInteger(y);
+    if (m_MaxSize != 0 && m_Points.size() >= m_MaxSize)
+    {
+        m_Points.clear();
+    }
+    m_Points[id] = value;
+    return 0;
+}
+
+int CGXCertificateCache::Verify(
+    CGXPublicKey& key,
+    CGXByteBuffer& signature,
+    CGXByteBuffer& data,
+    bool& value)
+{
+    int ret;
+    CGXEccPoint point;
+    value = false;
+    if ((ret = GetPoint(key, point)) == 0)
+    {
+        CGXEcdsa ecdsa(key);
+        ret = ecdsa.Verify(point, signature, data, value);
+    }
+    return ret;
+}
+
+int CGXCertificateCache::GenerateSecret(
+    CGXPrivateKey& privateKey,
+    CGXPublicKey& publicKey,
+    CGXByteBuffer& secret)
+{
+    int ret;
+    std::string key;
+    CGXByteArray& raw = privateKey.GetRawValue();
+    if (raw.GetSize() == 0 || publicKey.GetRawValue().GetSize() == 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if ((ret = GetHash(raw.GetData(), raw.GetSize(), key)) != 0)
+    {
+        return ret;
+    }
+    key.append((char*)publicKey.GetRawValue().GetData(), publicKey.GetRawValue().GetSize());
+    std::map<std::string, CGXByteBuffer>::iterator it = m_Secrets.find(key);
+    secret.Clear();
+    if (it != m_Secrets.end())
+    {
+        ++m_Hits;
+        return secret.Set(it->second.GetData(), it->second.GetSize());
+    }
+    ++m_Misses;
+    CGXEcdsa ecdsa(privateKey);
+    if ((ret = ecdsa.GenerateSecret(publicKey, secret)) != 0)
+    {
+        return ret;
+    }
+    if (m_MaxSize != 0 && m_Secrets.size() >= m_MaxSize)
+    {
+        m_Secrets.clear();
+    }
+    m_Secrets[key] = secret;
+    return 0;
+}
+
+void CGXCertificateCache::Clear()
+{
+    m_Certificates.clear();
+    m_Points.clear();
+    m_Secrets.clear();
+    m_Hits = 0;
+    m_Misses = 0;
+}
@@ -57,6 +57,7 @@ void CGXCipher::Init(
     m_BlockCipherKey.Set(BLOCKCIPHERKEY, sizeof(BLOCKCIPHERKEY));
     m_AuthenticationKey.Set(AUTHENTICATIONKEY, sizeof(AUTHENTICATIONKEY));
     m_SecuritySuite = DLMS_SECURITY_SUITE_V0;
+    m_CertificateCache = NULL;
 }
 
 CGXCipher::CGXCipher(CGXByteBuffer& systemTitle)
@@ -92,16 +93,17 @@ CGXCipher::~CGXCipher()
 static int GetNonse(
     unsigned long frameCounter,
     CGXByteBuffer& systemTitle,
-    CGXByteBuffer& nonce)
+    unsigned char* nonce)
 {
     if (systemTitle.GetSize() != 8)
     {
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
-    nonce.SetSize(0);
-    nonce.Capacity(12);
-    nonce.Set(systemTitle.GetData(), systemTitle.GetSize());
-    nonce.SetUInt32(frameCounter);
+    memcpy(nonce, systemTitle.GetData(), 8);
+    nonce[8] = (unsigned char)(frameCounter >> 24);
+    nonce[9] = (unsigned char)(frameCounter >> 16);
+    nonce[10] = (unsigned char)(frameCounter >> 8);
+    nonce[11] = (unsigned char)frameCounter;
     return 0;
 }
 
@@ -341,65 +343,130 @@ void CGXCipher::Xor(
     *d++ ^= *s++;
 }
 
-void CGXCipher::shift_right_block(unsigned char* v)
+//Reduction values for the 4-bit GHASH table.
+static const uint64_t LAST4[16] =
 {
-    unsigned long val = GETU32(v + 12);
-    val >>= 1;
-    if (v[11] & 0x01)
+    0x0000, 0x1c20, 0x3840, 0x2460,
+    0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560,
+    0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+int CGXCipher::InitContext(
+    CGXCipherContext& context,
+    const unsigned char* key,
+    unsigned short keyBits)
+{
+    int ret, i, j;
+    uint64_t vh, vl;
+    context.Invalidate();
+    if ((ret = Int(context.m_RoundKeys, key, keyBits)) != 0)
+    {
+        return ret;
+    }
+    context.m_RoundKeys[60] = keyBits == 256 ? 14 : 10;
+    //Hash subkey.
+    memset(context.m_H, 0, sizeof(context.m_H));
+    AesEncrypt(context.m_RoundKeys, context.m_RoundKeys[60], context.m_H, context.m_H);
+    //Multiples of H are counted only once for each key.
+    vh = ((uint64_t)GETU32(context.m_H) << 32) | GETU32(context.m_H + 4);
+    vl = ((uint64_t)GETU32(context.m_H + 8) << 32) | GETU32(context.m_H + 12);
+    context.m_HL[8] = vl;
+    context.m_HH[8] = vh;
+    context.m_HL[0] = 0;
+    context.m_HH[0] = 0;
+    for (i = 4; i > 0; i >>= 1)
     {
-        val |= 0x80000000;
+        uint32_t t = (uint32_t)(vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)t << 32);
+        context.m_HL[i] = vl;
+        context.m_HH[i] = vh;
     }
-    PUT32(v + 12, val);
-
-    val = GETU32(v + 8);
-    val >>= 1;
-    if (v[7] & 0x01)
-        val |= 0x80000000;
-    PUT32(v + 8, val);
-
-    val = GETU32(v + 4);
-    val >>= 1;
-    if (v[3] & 0x01)
-        val |= 0x80000000;
-    PUT32(v + 4, val);
-
-    val = GETU32(v);
-    val >>= 1;
-    PUT32(v, val);
+    for (i = 2; i <= 8; i *= 2)
+    {
+        vh = context.m_HH[i];
+        vl = context.m_HL[i];
+        for (j = 1; j < i; ++j)
+        {
+            context.m_HH[i + j] = vh ^ context.m_HH[j];
+            context.m_HL[i + j] = vl ^ context.m_HL[j];
+        }
+    }
+    memcpy(context.m_Key, key, keyBits / 8);
+    context.m_KeyBits = keyBits;
+    return 0;
 }
 
-void CGXCipher::MultiplyH(const unsigned char* x, const unsigned char* y, unsigned char* z)
+int CGXCipher::GetContext(
+    CGXByteBuffer& key,
+    DLMS_SECURITY_SUITE suite,
+    CGXCipherContext*& context)
 {
-    unsigned char tmp[16];
-    int i, j;
-
-    memset(z, 0, 16);
-    memcpy(tmp, y, 16);
+    unsigned short keyBits = suite == DLMS_SECURITY_SUITE_V2 ? 256 : 128;
+    if (key.GetSize() < (unsigned long)(keyBits / 8))
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if (&key == &m_BlockCipherKey)
+    {
+        context = &m_BlockCipherContext;
+    }
+    else if (&key == &m_DedicatedKey)
+    {
+        context = &m_DedicatedContext;
+    }
+    else
+    {
+        context = &m_Context;
+    }
+    //Key bytes are compared because key can be changed using the reference.
+    if (!context->IsValid(key.m_Data, keyBits))
+    {
+        return InitContext(*context, key.m_Data, keyBits);
+    }
+    return 0;
+}
 
-    for (i = 0; i < 16; i++)
+void CGXCipher::MultiplyH(
+    const CGXCipherContext& context,
+    const unsigned char* x,
+    unsigned char* z)
+{
+    int i;
+    unsigned char lo, hi, rem;
+    uint64_t zh, zl;
+    lo = x[15] & 0xf;
+    zh = context.m_HH[lo];
+    zl = context.m_HL[lo];
+    for (i = 15; i >= 0; --i)
     {
-        for (j = 0; j < 8; j++)
+        lo = x[i] & 0xf;
+        hi = (x[i] >> 4) & 0xf;
+        if (i != 15)
         {
-            if (x[i] & 1 << (7 - j))
-            {
-                Xor(z, tmp);
-            }
-            //If last bit.
-            if (tmp[15] & 0x01)
-            {
-                shift_right_block(tmp);
-                tmp[0] ^= 0xe1;
-            }
-            else
-            {
-                shift_right_block(tmp);
-            }
+            rem = (unsigned char)zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4);
+            zh ^= LAST4[rem] << 48;
+            zh ^= context.m_HH[lo];
+            zl ^= context.m_HL[lo];
         }
+        rem = (unsigned char)zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4);
+        zh ^= LAST4[rem] << 48;
+        zh ^= context.m_HH[hi];
+        zl ^= context.m_HL[hi];
     }
+    PUT32(z, (unsigned long)(zh >> 32));
+    PUT32(z + 4, (unsigned long)zh);
+    PUT32(z + 8, (unsigned long)(zl >> 32));
+    PUT32(z + 12, (unsigned long)zl);
 }
 
 void CGXCipher::GetGHash(
-    const unsigned char* h,
+    const CGXCipherContext& context,
     const unsigned char* x,
     int xlen,
     unsigned char* y)
@@ -412,7 +479,7 @@ void CGXCipher::GetGHash(
     {
         Xor(y, xpos);
         xpos += 16;
-        MultiplyH(y, h, tmp);
+        MultiplyH(context, y, tmp);
         memcpy(y, tmp, 16);
     }
     if (x + xlen > xpos)
@@ -423,7 +490,7 @@ void CGXCipher::GetGHash(
 
         Xor(y, tmp);
 
-        MultiplyH(y, h, tmp);
+        MultiplyH(context, y, tmp);
         memcpy(y, tmp, 16);
     }
 }
@@ -431,7 +498,7 @@ void CGXCipher::GetGHash(
 void CGXCipher::Init_j0(
     const unsigned char* iv,
     unsigned char len,
-    const unsigned char* H,
+    const CGXCipherContext& context,
     unsigned char* J0)
 {
     unsigned char tmp[16];
@@ -445,14 +512,14 @@ void CGXCipher::Init_j0(
     else
     {
         memset(J0, 0, 16);
-        GetGHash(H, iv, len, J0);
+        GetGHash(context, iv, len, J0);
         PUT32(tmp, (unsigned long)0);
         PUT32(tmp + 4, (unsigned long)0);
         //Here is expected that data is newer longger than 32 bit.
         //This is done because microcontrollers show warning here.
         PUT32(tmp + 8, (unsigned long)0);
         PUT32(tmp + 12, (unsigned long)(len * 8));
-        GetGHash(H, tmp, sizeof(tmp), J0);
+        GetGHash(context, tmp, sizeof(tmp), J0);
     }
 }
 
@@ -529,19 +596,19 @@ void CGXCipher::AesGcmGctr(unsigned int* aes, const unsigned char* J0, unsigned
     Gctr(aes, J0inc, in, len, out);
 }
 
-void CGXCipher::AesGcmGhash(const unsigned char* H, const unsigned char* aad, int aad_len,
+void CGXCipher::AesGcmGhash(const CGXCipherContext& context, const unsigned char* aad, int aad_len,
     const unsigned char* crypt, int crypt_len, unsigned char* S)
 {
     unsigned char len_buf[16];
-    GetGHash(H, aad, aad_len, S);
-    GetGHash(H, crypt, crypt_len, S);
+    GetGHash(context, aad, aad_len, S);
+    GetGHash(context, crypt, crypt_len, S);
     //Here is expected that data is never longer than 32 bit.
     //This is done because microcontrollers show warning here.
     PUT32(len_buf, (unsigned long)0);
     PUT32(len_buf + 4, (unsigned long)(aad_len * 8));
     PUT32(len_buf + 8, (unsigned long)0);
     PUT32(len_buf + 12, (unsigned long)(crypt_len * 8));
-    GetGHash(H, len_buf, sizeof(len_buf), S);
+    GetGHash(context, len_buf, sizeof(len_buf), S);
 }
 
 #endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
@@ -567,11 +634,12 @@ int CGXCipher::Encrypt(
 #endif // _DEBUG
     int ret;
 #ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
-    uint32_t aes[61] = { 0 };
-    unsigned char H[16] = { 0 };
+    CGXCipherContext* context;
+    unsigned int* aes;
+    unsigned char nonce[12];
+    unsigned char authTag[12];
     unsigned char J0[16] = { 0 };
     unsigned char S[16] = { 0 };
-    CGXByteBuffer aad;
 #endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
     CGXByteBuffer nonse;
     if (systemTitle.GetSize() != 8)
@@ -613,32 +681,27 @@ int CGXCipher::Encrypt(
         return ret;
     }
 #else
-    if ((ret = GetNonse(frameCounter, systemTitle, nonse)) != 0)
+    if ((ret = GetNonse(frameCounter, systemTitle, nonce)) != 0)
     {
         return ret;
     }
-    if ((ret = Int(aes, key.m_Data, suite == DLMS_SECURITY_SUITE_V2 ? 32 * 8 : 16 * 8)) != 0)
+    //Expanded key and GHASH table are reused while the key is not changed.
+    if ((ret = GetContext(key, suite, context)) != 0)
     {
         return ret;
     }
-    if (suite == DLMS_SECURITY_SUITE_V2)
-    {
-        aes[60] = 14;
-    }
-    else
-    {
-        aes[60] = 10;
-    }
-    //Hash subkey.
-    AesEncrypt(aes, aes[60], H, H);
-    Init_j0(nonse.m_Data, (unsigned char)nonse.GetSize(), H, J0);
+    aes = (unsigned int*)context->m_RoundKeys;
+    Init_j0(nonce, sizeof(nonce), *context, J0);
 
     //Allocate space for authentication tag.
     if (security != DLMS_SECURITY_ENCRYPTION && !encrypt)
     {
-        //Save authentication key to nonse.
-        nonse.Clear();
-        nonse.Set(input.GetData() + input.GetSize() - 12, 12);
+        if (input.GetSize() < 12)
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+        //Save authentication tag.
+        memcpy(authTag, input.GetData() + input.GetSize() - 12, 12);
         input.SetSize(input.GetSize() - 12);
     }
     unsigned char offset;
@@ -656,7 +719,7 @@ int CGXCipher::Encrypt(
         input.m_Position = 0;
         input.SetUInt8(0, security | suite);
         memcpy(input.m_Data + 1, m_AuthenticationKey.m_Data, m_AuthenticationKey.GetSize());
-        AesGcmGhash(H, input.m_Data, input.m_Size, input.m_Data, 0, S);
+        AesGcmGhash(*context, input.m_Data, input.m_Size, input.m_Data, 0, S);
         if (type == DLMS_COUNT_TYPE_TAG)
         {
             input.m_Size = 0;
@@ -672,7 +735,7 @@ int CGXCipher::Encrypt(
         }
         else
         {
-            if (memcmp(nonse.m_Data, input.m_Data + input.m_Size, 12) != 0)
+            if (memcmp(authTag, input.m_Data + input.m_Size, 12) != 0)
             {
                 ret = DLMS_ERROR_CODE_INVALID_TAG;
             }
@@ -695,7 +758,7 @@ int CGXCipher::Encrypt(
         input.m_Position = 0;
         input.SetUInt8(0, security | suite);
         memcpy(input.m_Data + 1, m_AuthenticationKey.m_Data, m_AuthenticationKey.GetSize());
-        AesGcmGhash(H, input.m_Data, offset, input.m_Data + offset, input.m_Size - offset, S);
+        AesGcmGhash(*context, input.m_Data, offset, input.m_Data + offset, input.m_Size - offset, S);
         input.Move(offset, 0, input.m_Size - offset);
         Gctr(aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
         if (!encrypt)
@@ -710,7 +773,7 @@ int CGXCipher::Encrypt(
         }
         else
         {
-            if (memcmp(nonse.m_Data, input.m_Data + input.m_Size, 12) != 0)
+            if (memcmp(authTag, input.m_Data + input.m_Size, 12) != 0)
             {
                 ret = DLMS_ERROR_CODE_INVALID_TAG;
             }
@@ -861,119 +924,101 @@ static unsigned char GaloisMultiply(unsigned char value)
     }
 }
 
-int CGXCipher::Aes1Encrypt(
-    CGXByteBuffer& buff,
-    unsigned short offset,
-    CGXByteBuffer& secret)
+void CGXCipher::Aes1ExpandKey(
+    const unsigned char* secret,
+    unsigned char* roundKeys)
+{
+    unsigned char round, i;
+    memcpy(roundKeys, secret, 16);
+    for (round = 0; round < 10; ++round)
+    {
+        const unsigned char* key = roundKeys + 16 * round;
+        unsigned char* next = roundKeys + 16 * (round + 1);
+        next[0] = (S_BOX[key[13] & 0xFF] ^ key[0] ^ R_CON[round]);
+        next[1] = (S_BOX[key[14] & 0xFF] ^ key[1]);
+        next[2] = (S_BOX[key[15] & 0xFF] ^ key[2]);
+        next[3] = (S_BOX[key[12] & 0xFF] ^ key[3]);
+        for (i = 4; i < 16; i++)
+        {
+            next[i] = (key[i] ^ next[i - 4]);
+        }
+    }
+}
+
+void CGXCipher::Aes1Encrypt(
+    unsigned char* data,
+    const unsigned char* roundKeys)
 {
     unsigned char buf1, buf2, buf3, buf4, round, i;
-    unsigned char* key = secret.m_Data;
-    unsigned char* data = buff.m_Data;
     for (round = 0; round < 10; ++round)
     {
+        const unsigned char* key = roundKeys + 16 * round;
         for (i = 0; i < 16; ++i)
         {
-            data[i + offset] = S_BOX[(data[i + offset] ^ key[i]) & 0xFF];
+            data[i] = S_BOX[(data[i] ^ key[i]) & 0xFF];
         }
         // shift rows
-        buf1 = data[1 + offset];
-        data[1 + offset] = data[5 + offset];
-        data[5 + offset] = data[9 + offset];
-        data[9 + offset] = data[13 + offset];
-        data[13 + offset] = buf1;
-
-        buf1 = data[2 + offset];
-        buf2 = data[6 + offset];
-        data[2 + offset] = data[10 + offset];
-        data[6 + offset] = data[14 + offset];
-        data[10 + offset] = buf1;
-        data[14 + offset] = buf2;
-
-        buf1 = data[15 + offset];
-        data[15 + offset] = data[11 + offset];
-        data[11 + offset] = data[7 + offset];
-        data[7 + offset] = data[3 + offset];
-        data[3 + offset] = buf1;
+        buf1 = data[1];
+        data[1] = data[5];
+        data[5] = data[9];
+        data[9] = data[13];
+        data[13] = buf1;
+
+        buf1 = data[2];
+        buf2 = data[6];
+        data[2] = data[10];
+        data[6] = data[14];
+        data[10] = buf1;
+        data[14] = buf2;
+
+        buf1 = data[15];
+        data[15] = data[11];
+        data[11] = data[7];
+        data[7] = data[3];
+        data[3] = buf1;
 
         if (round < 9)
         {
             for (i = 0; i < 4; i++)
             {
                 buf4 = (i << 2);
-                buf1 = (data[buf4 + offset] ^ data[buf4 + 1 + offset]
-                    ^ data[buf4 + 2 + offset]
-                    ^ data[buf4 + 3 + offset]);
-                buf2 = data[buf4 + offset];
-                buf3 = (data[buf4 + offset]
-                    ^ data[buf4 + 1 + offset]);
+                buf1 = (data[buf4] ^ data[buf4 + 1] ^ data[buf4 + 2] ^ data[buf4 + 3]);
+                buf2 = data[buf4];
+                buf3 = (data[buf4] ^ data[buf4 + 1]);
                 buf3 = GaloisMultiply(buf3);
-                data[buf4 + offset] =
-                    (data[buf4 + offset] ^ buf3 ^ buf1);
-                buf3 = (data[buf4 + 1 + offset]
-                    ^ data[buf4 + 2 + offset]);
+                data[buf4] = (data[buf4] ^ buf3 ^ buf1);
+                buf3 = (data[buf4 + 1] ^ data[buf4 + 2]);
                 buf3 = GaloisMultiply(buf3);
-                data[buf4 + 1 + offset] =
-                    (data[buf4 + 1 + offset] ^ buf3 ^ buf1);
-                buf3 = (data[buf4 + 2 + offset]
-                    ^ data[buf4 + 3 + offset]);
+                data[buf4 + 1] = (data[buf4 + 1] ^ buf3 ^ buf1);
+                buf3 = (data[buf4 + 2] ^ data[buf4 + 3]);
                 buf3 = GaloisMultiply(buf3);
-                data[buf4 + 2 + offset] = (data[buf4 + 2 + offset] ^ buf3 ^ buf1);
-                buf3 = (data[buf4 + 3 + offset] ^ buf2);
+                data[buf4 + 2] = (data[buf4 + 2] ^ buf3 ^ buf1);
+                buf3 = (data[buf4 + 3] ^ buf2);
                 buf3 = GaloisMultiply(buf3);
-                data[buf4 + 3 + offset] = (data[buf4 + 3 + offset] ^ buf3 ^ buf1);
+                data[buf4 + 3] = (data[buf4 + 3] ^ buf3 ^ buf1);
             }
         }
-
-        key[0] = (S_BOX[key[13] & 0xFF] ^ key[0] ^ R_CON[round]);
-        key[1] = (S_BOX[key[14] & 0xFF] ^ key[1]);
-        key[2] = (S_BOX[key[15] & 0xFF] ^ key[2]);
-        key[3] = (S_BOX[key[12] & 0xFF] ^ key[3]);
-        for (i = 4; i < 16; i++)
-        {
-            key[i] = (key[i] ^ key[i - 4]);
-        }
     }
-
+    roundKeys += 160;
     for (i = 0; i < 16; i++)
     {
-        data[i + offset] = (data[i + offset] ^ key[i]);
+        data[i] = (data[i] ^ roundKeys[i]);
     }
-    return 0;
 }
 
-int CGXCipher::Aes1Decrypt(
-    CGXByteBuffer& buff,
-    CGXByteBuffer& secret)
+void CGXCipher::Aes1Decrypt(
+    unsigned char* data,
+    const unsigned char* roundKeys)
 {
     unsigned char buf1, buf2, buf3, round, i;
     int buf4;
-    CGXByteBuffer key2;
-    key2.Set(&secret, 0, secret.GetSize());
-    unsigned char* data = buff.GetData();
-    unsigned char* key = key2.GetData();
-    for (round = 0; round < 10; round++) {
-        key[0] = (S_BOX[key[13] & 0xFF] ^ key[0] ^ R_CON[round]);
-        key[1] = (S_BOX[key[14] & 0xFF] ^ key[1]);
-        key[2] = (S_BOX[key[15] & 0xFF] ^ key[2]);
-        key[3] = (S_BOX[key[12] & 0xFF] ^ key[3]);
-        for (i = 4; i < 16; i++) {
-            key[i] = (key[i] ^ key[i - 4]);
-        }
-    }
-
+    const unsigned char* key = roundKeys + 160;
     for (i = 0; i < 16; i++) {
         data[i] = (data[i] ^ key[i]);
     }
 
     for (round = 0; round < 10; ++round) {
-        for (i = 15; i > 3; --i) {
-            key[i] = (key[i] ^ key[i - 4]);
-        }
-        key[0] = (S_BOX[key[13] & 0xFF] ^ key[0] ^ R_CON[9 - round]);
-        key[1] = (S_BOX[key[14] & 0xFF] ^ key[1]);
-        key[2] = (S_BOX[key[15] & 0xFF] ^ key[2]);
-        key[3] = (S_BOX[key[12] & 0xFF] ^ key[3]);
-
+        key = roundKeys + 16 * (9 - round);
         if (round > 0) {
             for (i = 0; i < 4; i++) {
                 buf4 = (i << 2) & 0xFF;
@@ -1027,6 +1072,28 @@ int CGXCipher::Aes1Decrypt(
             data[i] = (S_BOX_REVERSED[data[i] & 0xFF] ^ key[i]);
         }
     }
+}
+
+int CGXCipher::Aes1Encrypt(
+    CGXByteBuffer& buff,
+    unsigned short offset,
+    CGXByteBuffer& secret)
+{
+    unsigned char roundKeys[176];
+    Aes1ExpandKey(secret.m_Data, roundKeys);
+    Aes1Encrypt(buff.m_Data + offset, roundKeys);
+    //Secret is updated to the last round key as before.
+    memcpy(secret.m_Data, roundKeys + 160, 16);
+    return 0;
+}
+
+int CGXCipher::Aes1Decrypt(
+    CGXByteBuffer& buff,
+    CGXByteBuffer& secret)
+{
+    unsigned char roundKeys[176];
+    Aes1ExpandKey(secret.m_Data, roundKeys);
+    Aes1Decrypt(buff.m_Data, roundKeys);
     return 0;
 }
 
@@ -1093,6 +1160,9 @@ int CGXCipher::SetBlockCipherKey(CGXByteBuffer& value)
     }
     m_BlockCipherKey.Clear();
     m_BlockCipherKey.Set(value.m_Data, value.m_Size - value.m_Position);
+#ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+    m_BlockCipherContext.Invalidate();
+#endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
     return 0;
 }
 
@@ -1111,6 +1181,11 @@ int CGXCipher::SetAuthenticationKey(CGXByteBuffer& value)
     }
     m_AuthenticationKey.Clear();
     m_AuthenticationKey.Set(value.m_Data, value.m_Size - value.m_Position);
+#ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+    m_BlockCipherContext.Invalidate();
+    m_DedicatedContext.Invalidate();
+    m_Context.Invalidate();
+#endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
     return 0;
 }
 
@@ -1147,6 +1222,9 @@ CGXByteBuffer& CGXCipher::GetDedicatedKey()
 void CGXCipher::SetDedicatedKey(CGXByteBuffer& value)
 {
     m_DedicatedKey = value;
+#ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+    m_DedicatedContext.Invalidate();
+#endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
 }
 
 std::pair<CGXPublicKey, CGXPrivateKey>& CGXCipher::GetKeyAgreementKeyPair()
@@ -1182,3 +1260,13 @@ void CGXCipher::SetCertificates(
 {
     m_Certificates = value;
 }
+
+CGXCertificateCache* CGXCipher::GetCertificateCache()
+{
+    return m_CertificateCache;
+}
+
+void CGXCipher::SetCertificateCache(CGXCertificateCache* value)
+{
+    m_CertificateCache = value;
+}
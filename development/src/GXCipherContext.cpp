@@ -0,0 +1,73 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <string.h>
+#include "../include/GXCipherContext.h"
+
+#ifndef DLMS_USE_AES_HARDWARE_SECURITY_MODULE
+
+CGXCipherContext::CGXCipherContext()
+{
+    m_KeyBits = 0;
+}
+
+CGXCipherContext::~CGXCipherContext()
+{
+    Invalidate();
+}
+
+bool CGXCipherContext::IsValid(
+    const unsigned char* key,
+    unsigned short keyBits)
+{
+    return m_KeyBits != 0 && m_KeyBits == keyBits &&
+        memcmp(m_Key, key, keyBits / 8) == 0;
+}
+
+void CGXCipherContext::Invalidate()
+{
+    if (m_KeyBits != 0)
+    {
+        //Clear key material.
+        memset(m_Key, 0, sizeof(m_Key));
+        memset(m_RoundKeys, 0, sizeof(m_RoundKeys));
+        memset(m_H, 0, sizeof(m_H));
+        memset(m_HL, 0, sizeof(m_HL));
+        memset(m_HH, 0, sizeof(m_HH));
+        m_KeyBits = 0;
+    }
+}
+
+#endif //DLMS_USE_AES_HARDWARE_SECURITY_MODULE
@@ -32,6 +32,7 @@
 // Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
 //---------------------------------------------------------------------------
 
+#include <string.h>
 #include "../include/GXDLMS.h"
 #include "../include/GXAPDU.h"
 #include "../include/GXDLMSClient.h"
@@ -248,13 +249,20 @@ int CGXDLMS::ReceiverReady(
      *            Wrapped data.
      * @return Wrapper frames.
 */
-int CGXDLMS::GetWrapperFrame(
+/**
+* Add wrapper header.
+*
+* settings: DLMS settings.
+* command: DLMS command.
+* size: Size of the data.
+* reply: Wrapper header is added here.
+*/
+static void AddWrapperHeader(
     CGXDLMSSettings& settings,
     DLMS_COMMAND command,
-    CGXByteBuffer& data,
+    unsigned short size,
     CGXByteBuffer& reply)
 {
-    reply.Clear();
     // Add version.
     reply.SetUInt16(1);
     if (settings.IsServer())
@@ -275,7 +283,17 @@ int CGXDLMS::GetWrapperFrame(
         reply.SetUInt16((unsigned short)settings.GetServerAddress());
     }
     // Data length.
-    reply.SetUInt16((unsigned short)data.GetSize());
+    reply.SetUInt16(size);
+}
+
+int CGXDLMS::GetWrapperFrame(
+    CGXDLMSSettings& settings,
+    DLMS_COMMAND command,
+    CGXByteBuffer& data,
+    CGXByteBuffer& reply)
+{
+    reply.Clear();
+    AddWrapperHeader(settings, command, (unsigned short)data.GetSize(), reply);
     // Data
     reply.Set(&data, data.GetPosition(), -1);
 
@@ -295,44 +313,70 @@ int CGXDLMS::GetWrapperFrame(
     return DLMS_ERROR_CODE_OK;
 }
 
-int CGXDLMS::GetHdlcFrame(
+/**
+* Add HDLC address to the frame.
+*
+* address: Address returned by GetAddress.
+* size: Address size in bytes.
+* reply: Frame where address is added.
+*/
+static int AddHdlcAddress(unsigned long address, int size, CGXByteBuffer& reply)
+{
+    if (size == 1)
+    {
+        return reply.SetUInt8((unsigned char)address);
+    }
+    if (size == 2)
+    {
+        return reply.SetUInt16((unsigned short)address);
+    }
+    if (size == 4)
+    {
+        return reply.SetUInt32(address);
+    }
+    return DLMS_ERROR_CODE_INVALID_PARAMETER;
+}
+
+int CGXDLMS::GetHdlcFrameHeader(
     CGXDLMSSettings& settings,
     unsigned char frame,
     CGXByteBuffer* data,
-    CGXByteBuffer& reply)
+    CGXByteBuffer& reply,
+    int& len)
 {
-    reply.Clear();
+    unsigned long start = reply.GetSize();
     unsigned short frameSize;
-    int ret, len;
-    CGXByteBuffer primaryAddress, secondaryAddress;
+    int ret;
+    unsigned long primaryAddress, secondaryAddress;
+    int primarySize, secondarySize;
     if (settings.IsServer())
     {
         if (frame == 0x13 && settings.GetPushClientAddress() != 0)
         {
-            if ((ret = GetAddressBytes(settings.GetPushClientAddress(), primaryAddress)) != 0)
+            if ((ret = GetAddress(settings.GetPushClientAddress(), primaryAddress, primarySize)) != 0)
             {
                 return ret;
             }
         }
         else
         {
-            if ((ret = GetAddressBytes(settings.GetClientAddress(), primaryAddress)) != 0)
+            if ((ret = GetAddress(settings.GetClientAddress(), primaryAddress, primarySize)) != 0)
             {
                 return ret;
             }
         }
-        if ((ret = GetAddressBytes(settings.GetServerAddress(), secondaryAddress)) != 0)
+        if ((ret = GetAddress(settings.GetServerAddress(), secondaryAddress, secondarySize)) != 0)
         {
             return ret;
         }
     }
     else
     {
-        if ((ret = GetAddressBytes(settings.GetServerAddress(), primaryAddress)) != 0)
+        if ((ret = GetAddress(settings.GetServerAddress(), primaryAddress, primarySize)) != 0)
         {
             return ret;
         }
-        if ((ret = GetAddressBytes(settings.GetClientAddress(), secondaryAddress)) != 0)
+        if ((ret = GetAddress(settings.GetClientAddress(), secondaryAddress, secondarySize)) != 0)
         {
             return ret;
         }
@@ -361,8 +405,8 @@ int CGXDLMS::GetHdlcFrame(
     {
         len = data->Available();
         // Is last packet.
-        if ((ret = reply.SetUInt8(0xA0 | (((7 + primaryAddress.GetSize() +
-            secondaryAddress.GetSize() + len) >> 8) & 0x7))) != 0)
+        if ((ret = reply.SetUInt8(0xA0 | (((7 + primarySize +
+            secondarySize + len) >> 8) & 0x7))) != 0)
         {
             return ret;
         }
@@ -371,8 +415,8 @@ int CGXDLMS::GetHdlcFrame(
     {
         len = frameSize;
         // More data to left.
-        if ((ret = reply.SetUInt8(0xA8 | (((7 + primaryAddress.GetSize() +
-            secondaryAddress.GetSize() + len) >> 8) & 0x7))) != 0)
+        if ((ret = reply.SetUInt8(0xA8 | (((7 + primarySize +
+            secondarySize + len) >> 8) & 0x7))) != 0)
         {
             return ret;
         }
@@ -380,25 +424,25 @@ int CGXDLMS::GetHdlcFrame(
     // Frame len.
     if (len == 0)
     {
-        ret = reply.SetUInt8((unsigned char)(5 + primaryAddress.GetSize() +
-            secondaryAddress.GetSize() + len));
+        ret = reply.SetUInt8((unsigned char)(5 + primarySize +
+            secondarySize + len));
     }
     else
     {
-        ret = reply.SetUInt8((unsigned char)(7 + primaryAddress.GetSize() +
-            secondaryAddress.GetSize() + len));
+        ret = reply.SetUInt8((unsigned char)(7 + primarySize +
+            secondarySize + len));
     }
     if (ret != 0)
     {
         return ret;
     }
     // Add primary address.
-    if ((ret = reply.Set(&primaryAddress)) != 0)
+    if ((ret = AddHdlcAddress(primaryAddress, primarySize, reply)) != 0)
     {
         return ret;
     }
     // Add secondary address.
-    if ((ret = reply.Set(&secondaryAddress)) != 0)
+    if ((ret = AddHdlcAddress(secondaryAddress, secondarySize, reply)) != 0)
     {
         return ret;
     }
@@ -417,11 +461,26 @@ int CGXDLMS::GetHdlcFrame(
         return ret;
     }
     // Add header CRC.
-    int crc = CountFCS16(reply, 1, reply.GetSize() - 1);
+    int crc = CountFCS16(reply, start + 1, reply.GetSize() - start - 1);
     if ((ret = reply.SetUInt16(crc)) != 0)
     {
         return ret;
     }
+    return DLMS_ERROR_CODE_OK;
+}
+
+int CGXDLMS::GetHdlcFrame(
+    CGXDLMSSettings& settings,
+    unsigned char frame,
+    CGXByteBuffer* data,
+    CGXByteBuffer& reply)
+{
+    int ret, len, crc;
+    reply.Clear();
+    if ((ret = GetHdlcFrameHeader(settings, frame, data, reply, len)) != 0)
+    {
+        return ret;
+    }
     if (len != 0)
     {
         // Add data.
@@ -1533,187 +1592,423 @@ int CGXDLMS::GetSnMessages(
     return 0;
 }
 
-int CGXDLMS::GetHdlcData(
-    bool server,
-    CGXDLMSSettings& settings,
-    CGXByteBuffer& reply,
-    CGXReplyData& data,
-    unsigned char& frame,
-    CGXReplyData* notify)
+/**
+* Update FCS16 with the given bytes. Count starts from 0xFFFF.
+*/
+static unsigned short UpdateFCS16(unsigned short fcs16, const unsigned char* data, unsigned long count)
 {
-    unsigned long packetStartID = reply.GetPosition(), frameLen = 0;
-    unsigned long pos;
-    unsigned char ch;
-    int ret;
-    unsigned short crc, crcRead;
-    bool isNotify = false;
-    // If whole frame is not received yet.
-    if (reply.GetSize() - reply.GetPosition() < 9)
+    for (unsigned long pos = 0; pos != count; ++pos)
     {
-        data.SetComplete(false);
-        return 0;
+        fcs16 = (fcs16 >> 8) ^ FCS16Table[(fcs16 ^ data[pos]) & 0xFF];
     }
-    data.SetComplete(true);
-    if (notify != NULL)
+    return fcs16;
+}
+
+/**
+* Get FCS16 in the byte order that is added to the frame.
+*/
+static unsigned short FinalFCS16(unsigned short fcs16)
+{
+    fcs16 = ~fcs16;
+    return ((fcs16 >> 8) & 0xFF) | (fcs16 << 8);
+}
+
+int CGXDLMS::AddFrames(
+    CGXDLMSSettings& settings,
+    DLMS_COMMAND command,
+    unsigned char frame,
+    long index,
+    CGXDLMSFrameWriter& writer)
+{
+    int ret, len;
+    unsigned long start;
+    unsigned short crc;
+    CGXByteBuffer tmp;
+    CGXByteBuffer& pdu = *writer.m_Pdus[index];
+    CGXByteBuffer& headers = writer.m_Headers;
+    while (pdu.GetPosition() != pdu.GetSize())
+    {
+        writer.NewFrame();
+        start = headers.GetSize();
+        switch (settings.GetInterfaceType())
+        {
+        case DLMS_INTERFACE_TYPE_WRAPPER:
+            AddWrapperHeader(settings, command, (unsigned short)pdu.GetSize(), headers);
+            writer.AddSegment(-1, start, headers.GetSize() - start);
+            writer.AddSegment(index, pdu.GetPosition(), pdu.Available());
+            pdu.SetPosition(pdu.GetSize());
+            break;
+        case DLMS_INTERFACE_TYPE_HDLC:
+        case DLMS_INTERFACE_TYPE_HDLC_WITH_MODE_E:
+            if ((ret = GetHdlcFrameHeader(settings, frame, &pdu, headers, len)) != 0)
+            {
+                return ret;
+            }
+            writer.AddSegment(-1, start, headers.GetSize() - start);
+            // Data CRC is counted over the header and the data without copying the data.
+            crc = UpdateFCS16(0xFFFF, headers.GetData() + start + 1, headers.GetSize() - start - 1);
+            start = headers.GetSize();
+            if (len != 0)
+            {
+                crc = UpdateFCS16(crc, pdu.GetData() + pdu.GetPosition(), len);
+                writer.AddSegment(index, pdu.GetPosition(), len);
+                pdu.SetPosition(pdu.GetPosition() + len);
+                headers.SetUInt16(FinalFCS16(crc));
+            }
+            // Add EOP
+            headers.SetUInt8(HDLC_FRAME_START_END);
+            writer.AddSegment(-1, start, headers.GetSize() - start);
+            if (pdu.GetPosition() != pdu.GetSize())
+            {
+                frame = settings.GetNextSend(0);
+            }
+            break;
+        case DLMS_INTERFACE_TYPE_PDU:
+            writer.AddSegment(index, pdu.GetPosition(), pdu.Available());
+            pdu.SetPosition(pdu.GetSize());
+            break;
+        case DLMS_INTERFACE_TYPE_PLC:
+        case DLMS_INTERFACE_TYPE_PLC_HDLC:
+            // PLC frames are padded. They are copied to the header buffer.
+            tmp.Clear();
+            if (settings.GetInterfaceType() == DLMS_INTERFACE_TYPE_PLC)
+            {
+                ret = GetPlcFrame(settings, 0x90, &pdu, tmp);
+            }
+            else
+            {
+                ret = GetMacHdlcFrame(settings, frame, 0, &pdu, tmp);
+            }
+            if (ret != 0)
+            {
+                return ret;
+            }
+            headers.Set(&tmp);
+            writer.AddSegment(-1, start, headers.GetSize() - start);
+            break;
+        default:
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+    }
+    return 0;
+}
+
+int CGXDLMS::GetLnMessages(
+    CGXDLMSLNParameters& p,
+    CGXDLMSFrameWriter& writer)
+{
+    int ret;
+    long index;
+    unsigned char frame = 0;
+    if (p.GetCommand() == DLMS_COMMAND_DATA_NOTIFICATION ||
+        p.GetCommand() == DLMS_COMMAND_EVENT_NOTIFICATION)
     {
-        notify->SetComplete(true);
+        frame = 0x13;
     }
-    // Find start of HDLC frame.
-    for (pos = reply.GetPosition(); pos < reply.GetSize(); ++pos)
+    do
     {
-        if ((ret = reply.GetUInt8(&ch)) != 0)
+        index = writer.NewPdu();
+        if ((ret = GetLNPdu(p, *writer.m_Pdus[index])) != 0)
         {
             return ret;
         }
-        if (ch == HDLC_FRAME_START_END)
+        p.SetLastBlock(true);
+        if (p.GetAttributeDescriptor() == NULL)
         {
-            packetStartID = pos;
-            break;
+            p.GetSettings()->IncreaseBlockIndex();
         }
-    }
-    // Not a HDLC frame.
-    // Sometimes meters can send some strange data between DLMS frames.
-    if (reply.GetPosition() == reply.GetSize())
-    {
-        data.SetComplete(false);
-        if (notify != NULL)
+        if ((ret = AddFrames(*p.GetSettings(), p.GetCommand(), frame, index, writer)) != 0)
         {
-            notify->SetComplete(false);
+            return ret;
         }
-        // Not enough data to parse;
-        return 0;
-    }
-    if ((ret = reply.GetUInt8(&frame)) != 0)
-    {
-        return ret;
-    }
-    if ((frame & 0xF0) != 0xA0)
-    {
-        reply.SetPosition(reply.GetPosition() - 1);
-        return GetHdlcData(server, settings, reply, data, frame, notify);
-    }
-    // Check frame length.
-    if ((frame & 0x7) != 0)
-    {
-        frameLen = ((frame & 0x7) << 8);
-    }
-    if ((ret = reply.GetUInt8(&ch)) != 0)
+        frame = 0;
+    } while (p.GetData() != NULL && p.GetData()->GetPosition() != p.GetData()->GetSize());
+    return 0;
+}
+
+int CGXDLMS::GetSnMessages(
+    CGXDLMSSNParameters& p,
+    CGXDLMSFrameWriter& writer)
+{
+    int ret;
+    long index;
+    unsigned char frame = 0x0;
+    if (p.GetCommand() == DLMS_COMMAND_INFORMATION_REPORT ||
+        p.GetCommand() == DLMS_COMMAND_DATA_NOTIFICATION)
     {
-        return ret;
+        frame = 0x13;
     }
-    // If not enough data.
-    frameLen += ch;
-    if (reply.GetSize() - reply.GetPosition() + 1 < frameLen)
+    do
     {
-        data.SetComplete(false);
-        reply.SetPosition(packetStartID);
-        // Not enough data to parse;
-        return 0;
-    }
-    int eopPos = frameLen + packetStartID + 1;
-    if ((ret = reply.GetUInt8(eopPos, &ch)) != 0)
+        index = writer.NewPdu();
+        if ((ret = GetSNPdu(p, *writer.m_Pdus[index])) != 0)
+        {
+            return ret;
+        }
+        if ((ret = AddFrames(*p.GetSettings(), p.GetCommand(), frame, index, writer)) != 0)
+        {
+            return ret;
+        }
+        frame = 0;
+    } while (p.GetData() != NULL && p.GetData()->GetPosition() != p.GetData()->GetSize());
+    return 0;
+}
+
+/**
+* Find next HDLC flag starting from given position.
+* memchr is vectorized by the C runtime so noise between frames is
+* skipped a block at the time instead of a byte at the time.
+*
+* reply: Received data.
+* pos: Start position.
+* Returns position of the flag or size of the buffer if flag is not found.
+*/
+static unsigned long FindHdlcFlag(CGXByteBuffer& reply, unsigned long pos)
+{
+    if (pos >= reply.GetSize())
     {
-        return ret;
+        return reply.GetSize();
     }
-    if (ch != HDLC_FRAME_START_END)
+    const unsigned char* p = (const unsigned char*)memchr(reply.GetData() + pos,
+        HDLC_FRAME_START_END, reply.GetSize() - pos);
+    if (p == NULL)
     {
-        reply.SetPosition(reply.GetPosition() - 2);
-        return GetHdlcData(server, settings, reply, data, frame, notify);
+        return reply.GetSize();
     }
+    return (unsigned long)(p - reply.GetData());
+}
 
-    // Check addresses.
-    unsigned long source, target;
-    ret = CheckHdlcAddress(server, settings, reply, eopPos, source, target);
-    if (ret != 0)
+/**
+* Get size of HDLC address without moving the position.
+*
+* reply: Received data.
+* pos: Start position of the address.
+* end: End of the frame.
+* Returns address size in bytes, zero if more data is needed
+* or -1 if address is not valid.
+*/
+static int GetHdlcAddressSize(CGXByteBuffer& reply, unsigned long pos, unsigned long end)
+{
+    for (int size = 1; size != 5; ++size, ++pos)
     {
-        if (ret != DLMS_ERROR_CODE_FALSE)
+        if (pos >= end)
         {
-            return ret;
+            return -1;
         }
-        //If not notify.
-        if (!(reply.GetPosition() < reply.GetSize() && reply.GetUInt8(reply.GetPosition(), &ch) == 0 && ch == 0x13))
+        if (pos >= reply.GetSize())
         {
-            //If echo.
-            reply.SetPosition(1 + eopPos);
-            return GetHdlcData(server, settings, reply, data, frame, notify);
+            return 0;
         }
-        else if (notify != NULL)
+        if ((reply.GetData()[pos] & 0x1) == 1)
         {
-            isNotify = true;
-            notify->SetClientAddress((unsigned short)target);
-            notify->SetServerAddress((int)source);
+            return size == 3 ? -1 : size;
         }
     }
-    // Is there more data available.
-    bool moreData = (frame & 0x8) != 0;
-    // Get frame type.
-    if ((ret = reply.GetUInt8(&frame)) != 0)
-    {
-        return ret;
-    }
-    //If server is using same client and server address for notifications.
-    if (frame == 0x13 && !isNotify && notify != NULL)
-    {
-        isNotify = true;
-        notify->SetClientAddress((unsigned short)target);
-        notify->SetServerAddress((int)source);
-    }
-    if (moreData)
+    return -1;
+}
+
+int CGXDLMS::GetHdlcData(
+    bool server,
+    CGXDLMSSettings& settings,
+    CGXByteBuffer& reply,
+    CGXReplyData& data,
+    unsigned char& frame,
+    CGXReplyData* notify)
+{
+    unsigned long packetStartID, frameLen, hcsPos;
+    int eopPos, target, source;
+    unsigned char ch;
+    int ret;
+    unsigned short crc, crcRead;
+    bool isNotify;
+    // Frames are searched until a valid frame is found or more data is needed.
+    // Length, flags and FCS are validated before settings are touched so noise
+    // that looks like a frame start is skipped without side effects.
+    for (;;)
     {
-        if (isNotify)
+        isNotify = false;
+        // If whole frame is not received yet.
+        if (reply.GetSize() - reply.GetPosition() < 9)
         {
-            notify->SetMoreData((DLMS_DATA_REQUEST_TYPES)(notify->GetMoreData() | DLMS_DATA_REQUEST_TYPES_FRAME));
+            data.SetComplete(false);
+            return 0;
         }
-        else
+        data.SetComplete(true);
+        if (notify != NULL)
         {
-            data.SetMoreData((DLMS_DATA_REQUEST_TYPES)(data.GetMoreData() | DLMS_DATA_REQUEST_TYPES_FRAME));
+            notify->SetComplete(true);
         }
-    }
-    else
-    {
-        if (isNotify)
+        // Find start of HDLC frame.
+        packetStartID = FindHdlcFlag(reply, reply.GetPosition());
+        // Not a HDLC frame.
+        // Sometimes meters can send some strange data between DLMS frames.
+        if (packetStartID == reply.GetSize())
+        {
+            reply.SetPosition(packetStartID);
+            data.SetComplete(false);
+            if (notify != NULL)
+            {
+                notify->SetComplete(false);
+            }
+            // Not enough data to parse;
+            return 0;
+        }
+        if (packetStartID != reply.GetPosition())
         {
-            notify->SetMoreData((DLMS_DATA_REQUEST_TYPES)(notify->GetMoreData() & ~DLMS_DATA_REQUEST_TYPES_FRAME));
+            reply.SetPosition(packetStartID);
+            continue;
+        }
+        frame = reply.GetData()[packetStartID + 1];
+        if ((frame & 0xF0) != 0xA0)
+        {
+            reply.SetPosition(packetStartID + 1);
+            continue;
+        }
+        // Check frame length.
+        frameLen = ((frame & 0x7) << 8) | reply.GetData()[packetStartID + 2];
+        // Frame must hold at least frame format, addresses, control field and HCS.
+        if (frameLen < 7)
+        {
+            reply.SetPosition(packetStartID + 1);
+            continue;
+        }
+        eopPos = frameLen + packetStartID + 1;
+        // Check header before waiting the rest of the frame.
+        if ((target = GetHdlcAddressSize(reply, packetStartID + 3, eopPos)) > 0)
+        {
+            source = GetHdlcAddressSize(reply, packetStartID + 3 + target, eopPos);
         }
         else
         {
-            data.SetMoreData((DLMS_DATA_REQUEST_TYPES)(data.GetMoreData() & ~DLMS_DATA_REQUEST_TYPES_FRAME));
+            source = target;
         }
-    }
-    if (!settings.CheckFrame(frame))
-    {
-        reply.SetPosition(eopPos + 1);
-        return GetHdlcData(server, settings, reply, data, frame, notify);
-    }
-    // Check that header CRC is correct.
-    crc = CountFCS16(reply, packetStartID + 1,
-        reply.GetPosition() - packetStartID - 1);
-
-    if ((ret = reply.GetUInt16(&crcRead)) != 0)
-    {
-        return ret;
-    }
-    if (crc != crcRead)
-    {
-        if (reply.GetSize() - reply.GetPosition() > 8)
+        if (source < 0)
         {
-            return GetHdlcData(server, settings, reply, data, frame, notify);
+            reply.SetPosition(packetStartID + 1);
+            continue;
         }
-        return DLMS_ERROR_CODE_WRONG_CRC;
-    }
-    // Check that packet CRC match only if there is a data part.
-    if (reply.GetPosition() != packetStartID + frameLen + 1)
-    {
-        crc = CountFCS16(reply, packetStartID + 1,
-            frameLen - 2);
-        if ((ret = reply.GetUInt16(packetStartID + frameLen - 1, &crcRead)) != 0)
+        // Position of HCS. Control field is after the addresses.
+        hcsPos = packetStartID + 4 + target + source;
+        if (source != 0 && hcsPos + 2 > (unsigned long)eopPos)
+        {
+            reply.SetPosition(packetStartID + 1);
+            continue;
+        }
+        if (source == 0 || hcsPos + 2 > reply.GetSize())
+        {
+            data.SetComplete(false);
+            // Not enough data to parse;
+            return 0;
+        }
+        crc = CountFCS16(reply, packetStartID + 1, hcsPos - packetStartID - 1);
+        if ((ret = reply.GetUInt16(hcsPos, &crcRead)) != 0)
         {
             return ret;
         }
         if (crc != crcRead)
         {
-            return DLMS_ERROR_CODE_WRONG_CRC;
+            reply.SetPosition(packetStartID + 1);
+            continue;
+        }
+        // If not enough data.
+        if (reply.GetSize() < (unsigned long)eopPos + 1)
+        {
+            data.SetComplete(false);
+            // Not enough data to parse;
+            return 0;
+        }
+        if (reply.GetData()[eopPos] != HDLC_FRAME_START_END)
+        {
+            reply.SetPosition(packetStartID + 1);
+            continue;
+        }
+        // Check that packet CRC match only if there is a data part.
+        if (hcsPos + 2 != (unsigned long)eopPos)
+        {
+            crc = CountFCS16(reply, packetStartID + 1, frameLen - 2);
+            if ((ret = reply.GetUInt16(packetStartID + frameLen - 1, &crcRead)) != 0)
+            {
+                return ret;
+            }
+            if (crc != crcRead)
+            {
+                // Frame is skipped. End flag can be the start of the next frame.
+                reply.SetPosition(eopPos);
+                return DLMS_ERROR_CODE_WRONG_CRC;
+            }
+        }
+        reply.SetPosition(packetStartID + 3);
+        // Check addresses.
+        unsigned long sourceAddress, targetAddress;
+        ret = CheckHdlcAddress(server, settings, reply, eopPos, sourceAddress, targetAddress);
+        if (ret != 0)
+        {
+            if (ret != DLMS_ERROR_CODE_FALSE)
+            {
+                return ret;
+            }
+            //If not notify.
+            if (!(reply.GetPosition() < reply.GetSize() && reply.GetUInt8(reply.GetPosition(), &ch) == 0 && ch == 0x13))
+            {
+                //If echo.
+                reply.SetPosition(1 + eopPos);
+                continue;
+            }
+            else if (notify != NULL)
+            {
+                isNotify = true;
+                notify->SetClientAddress((unsigned short)targetAddress);
+                notify->SetServerAddress((int)sourceAddress);
+            }
+        }
+        // Is there more data available.
+        bool moreData = (frame & 0x8) != 0;
+        // Get frame type.
+        if ((ret = reply.GetUInt8(&frame)) != 0)
+        {
+            return ret;
+        }
+        //If server is using same client and server address for notifications.
+        if (frame == 0x13 && !isNotify && notify != NULL)
+        {
+            isNotify = true;
+            notify->SetClientAddress((unsigned short)targetAddress);
+            notify->SetServerAddress((int)sourceAddress);
+        }
+        if (moreData)
+        {
+            if (isNotify)
+            {
+                notify->SetMoreData((DLMS_DATA_REQUEST_TYPES)(notify->GetMoreData() | DLMS_DATA_REQUEST_TYPES_FRAME));
+            }
+            else
+            {
+                data.SetMoreData((DLMS_DATA_REQUEST_TYPES)(data.GetMoreData() | DLMS_DATA_REQUEST_TYPES_FRAME));
+            }
+        }
+        else
+        {
+            if (isNotify)
+            {
+                notify->SetMoreData((DLMS_DATA_REQUEST_TYPES)(notify->GetMoreData() & ~DLMS_DATA_REQUEST_TYPES_FRAME));
+            }
+            else
+            {
+                data.SetMoreData((DLMS_DATA_REQUEST_TYPES)(data.GetMoreData() & ~DLMS_DATA_REQUEST_TYPES_FRAME));
+            }
+        }
+        if (!settings.CheckFrame(frame))
+        {
+            reply.SetPosition(eopPos + 1);
+            continue;
         }
+        // Skip HCS. It is already checked.
+        reply.SetPosition(hcsPos + 2);
+        break;
+    }
+    // If there is a data part.
+    if (reply.GetPosition() != packetStartID + frameLen + 1)
+    {
         // Remove CRC and EOP from packet length.
         if (isNotify)
         {
@@ -3897,7 +4192,11 @@ int CGXDLMS::HandleReadResponse(
             GetDataFromBlock(reply.GetData(), 0);
             return DLMS_ERROR_CODE_FALSE;
         }
-        reply.GetData().SetPosition(0);
+        //Count is removed from the data if it's received in blocks.
+        if (!first)
+        {
+            reply.GetData().SetPosition(0);
+        }
     }
     DLMS_SINGLE_READ_RESPONSE type;
     CGXDLMSVariant values;
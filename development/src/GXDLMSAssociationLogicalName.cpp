@@ -170,6 +170,25 @@ int CGXDLMSAssociationLogicalName::RemoveUser(CGXDLMSClient* client, unsigned ch
     return client->Method(this, 6, tmp, reply);
 }
 
+// Add object to LN Association View.
+int CGXDLMSAssociationLogicalName::AppendObject(
+    CGXDLMSSettings& settings,
+    CGXDLMSValueEventArg& e,
+    CGXDLMSObject* pObj,
+    CGXByteBuffer& data)
+{
+    data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+    data.SetUInt8(4);//Count
+    CGXDLMSVariant type = pObj->GetObjectType();
+    CGXDLMSVariant version = pObj->GetVersion();
+    GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT16, type);//ClassID
+    GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT8, version);//Version
+    CGXDLMSVariant ln(pObj->m_LN, 6, DLMS_DATA_TYPE_OCTET_STRING);
+    GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_OCTET_STRING, ln);//LN
+    //Access rights.
+    return GetAccessRights(pObj, e.GetServer(), data);
+}
+
 // Returns LN Association View.
 int CGXDLMSAssociationLogicalName::GetObjects(
     CGXDLMSSettings& settings,
@@ -192,16 +211,7 @@ int CGXDLMSAssociationLogicalName::GetObjects(
         ++pos;
         if (!(pos <= settings.GetIndex()))
         {
-            data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
-            data.SetUInt8(4);//Count
-            CGXDLMSVariant type = (*it)->GetObjectType();
-            CGXDLMSVariant version = (*it)->GetVersion();
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT16, type);//ClassID
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT8, version);//Version
-            CGXDLMSVariant ln((*it)->m_LN, 6, DLMS_DATA_TYPE_OCTET_STRING);
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_OCTET_STRING, ln);//LN
-            //Access rights.
-            if ((ret = GetAccessRights(*it, e.GetServer(), data)) != 0)
+            if ((ret = AppendObject(settings, e, *it, data)) != 0)
             {
                 return ret;
             };
@@ -219,6 +229,44 @@ int CGXDLMSAssociationLogicalName::GetObjects(
     return DLMS_ERROR_CODE_OK;
 }
 
+int CGXDLMSAssociationLogicalName::Produce(
+    CGXDLMSSettings& settings,
+    CGXDLMSValueEventArg& e,
+    unsigned long size,
+    CGXByteBuffer& data,
+    bool& completed)
+{
+    int ret;
+    unsigned long pos = e.GetProducerPosition();
+    if (e.GetIndex() != 2 || pos > m_ObjectList.size())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    unsigned long end = data.GetSize() + size;
+    //Add count only for first time.
+    if (pos == 0)
+    {
+        data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
+        GXHelpers::SetObjectCount((unsigned long)m_ObjectList.size(), data);
+    }
+    //At least one object is added.
+    do
+    {
+        if (pos == m_ObjectList.size())
+        {
+            break;
+        }
+        if ((ret = AppendObject(settings, e, m_ObjectList[pos], data)) != 0)
+        {
+            return ret;
+        }
+        ++pos;
+    } while (data.GetSize() < end);
+    e.SetProducerPosition(pos);
+    completed = pos == m_ObjectList.size();
+    return 0;
+}
+
 // Returns user list
 int CGXDLMSAssociationLogicalName::GetUsers(
     CGXDLMSSettings& settings,
@@ -0,0 +1,395 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#include <process.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <unistd.h>
+#endif //defined(_WIN32) || defined(_WIN64)
+#include "../include/GXDLMSBatchDecoder.h"
+#include "../include/GXDLMS.h"
+#include "../include/GXHelpers.h"
+
+CGXDLMSBatchItem::CGXDLMSBatchItem()
+{
+    m_Error = 0;
+    m_Security = DLMS_SECURITY_NONE;
+    m_SecuritySuite = DLMS_SECURITY_SUITE_V0;
+    m_InvocationCounter = 0;
+    m_Command = DLMS_COMMAND_NONE;
+}
+
+CGXDLMSBatchItem::CGXDLMSBatchItem(
+    CGXByteBuffer& systemTitle,
+    CGXByteBuffer& data)
+{
+    m_Error = 0;
+    m_Security = DLMS_SECURITY_NONE;
+    m_SecuritySuite = DLMS_SECURITY_SUITE_V0;
+    m_InvocationCounter = 0;
+    m_Command = DLMS_COMMAND_NONE;
+    m_SystemTitle = systemTitle;
+    m_Data = data;
+}
+
+CGXByteBuffer& CGXDLMSBatchItem::GetSystemTitle()
+{
+    return m_SystemTitle;
+}
+
+void CGXDLMSBatchItem::SetSystemTitle(CGXByteBuffer& value)
+{
+    m_SystemTitle = value;
+}
+
+CGXByteBuffer& CGXDLMSBatchItem::GetData()
+{
+    return m_Data;
+}
+
+void CGXDLMSBatchItem::SetData(CGXByteBuffer& value)
+{
+    m_Data = value;
+}
+
+int CGXDLMSBatchItem::GetError()
+{
+    return m_Error;
+}
+
+DLMS_SECURITY CGXDLMSBatchItem::GetSecurity()
+{
+    return m_Security;
+}
+
+DLMS_SECURITY_SUITE CGXDLMSBatchItem::GetSecuritySuite()
+{
+    return m_SecuritySuite;
+}
+
+uint64_t CGXDLMSBatchItem::GetInvocationCounter()
+{
+    return m_InvocationCounter;
+}
+
+DLMS_COMMAND CGXDLMSBatchItem::GetCommand()
+{
+    return m_Command;
+}
+
+CGXByteBuffer& CGXDLMSBatchItem::GetPlainText()
+{
+    return m_PlainText;
+}
+
+CGXDLMSVariant& CGXDLMSBatchItem::GetValue()
+{
+    return m_Value;
+}
+
+CGXDLMSBatchDecoder::CGXDLMSBatchDecoder(bool useLogicalNameReferencing)
+{
+    m_UseLogicalNameReferencing = useLogicalNameReferencing;
+    m_ThreadCount = 0;
+}
+
+int CGXDLMSBatchDecoder::GetThreadCount()
+{
+    return m_ThreadCount;
+}
+
+void CGXDLMSBatchDecoder::SetThreadCount(int value)
+{
+    m_ThreadCount = value;
+}
+
+int CGXDLMSBatchDecoder::AddKeys(
+    CGXByteBuffer& systemTitle,
+    CGXByteBuffer& blockCipherKey,
+    CGXByteBuffer& authenticationKey,
+    CGXByteBuffer& dedicatedKey)
+{
+    if (systemTitle.GetSize() != 8 ||
+        (blockCipherKey.GetSize() != 16 && blockCipherKey.GetSize() != 32) ||
+        authenticationKey.GetSize() != blockCipherKey.GetSize())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXDLMSBatchKeys& keys = m_Keys[std::string((char*)systemTitle.GetData(), systemTitle.GetSize())];
+    keys.m_BlockCipherKey = blockCipherKey;
+    keys.m_AuthenticationKey = authenticationKey;
+    keys.m_DedicatedKey = dedicatedKey;
+    return 0;
+}
+
+void CGXDLMSBatchDecoder::ClearKeys()
+{
+    m_Keys.clear();
+}
+
+/**
+* Is dedicated key used to cipher the command.
+*/
+static bool IsDedicated(unsigned char cmd)
+{
+    switch (cmd)
+    {
+    case DLMS_COMMAND_DED_GET_REQUEST:
+    case DLMS_COMMAND_DED_GET_RESPONSE:
+    case DLMS_COMMAND_DED_SET_REQUEST:
+    case DLMS_COMMAND_DED_SET_RESPONSE:
+    case DLMS_COMMAND_DED_METHOD_REQUEST:
+    case DLMS_COMMAND_DED_METHOD_RESPONSE:
+    case DLMS_COMMAND_DED_EVENT_NOTIFICATION:
+    case DLMS_COMMAND_GENERAL_DED_CIPHERING:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+int CGXDLMSBatchDecoder::Decode(
+    CGXDLMSSettings& settings,
+    CGXDLMSBatchItem& item)
+{
+    int ret;
+    unsigned char cmd;
+    unsigned long length;
+    CGXByteBuffer data, generalTitle;
+    CGXByteBuffer* title = &item.m_SystemTitle;
+    CGXCipher* cipher = settings.GetCipher();
+    item.m_Command = DLMS_COMMAND_NONE;
+    item.m_PlainText.Clear();
+    item.m_Value.Clear();
+    data.Set(item.m_Data.GetData(), item.m_Data.GetSize());
+    if ((ret = data.GetUInt8(0, &cmd)) != 0)
+    {
+        return ret;
+    }
+    if (cmd == DLMS_COMMAND_GENERAL_CIPHERING)
+    {
+        //General-ciphering is not supported.
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    //General ciphering APDU tells the system title of the sender.
+    if (cmd == DLMS_COMMAND_GENERAL_GLO_CIPHERING ||
+        cmd == DLMS_COMMAND_GENERAL_DED_CIPHERING)
+    {
+        data.SetPosition(1);
+        if ((ret = GXHelpers::GetObjectCount(data, length)) != 0)
+        {
+            return ret;
+        }
+        if (length != 0)
+        {
+            if ((ret = generalTitle.Set(&data, data.GetPosition(), length)) != 0)
+            {
+                return ret;
+            }
+            title = &generalTitle;
+        }
+        data.SetPosition(0);
+    }
+    std::map<std::string, CGXDLMSBatchKeys>::iterator it =
+        m_Keys.find(std::string((char*)title->GetData(), title->GetSize()));
+    if (it == m_Keys.end())
+    {
+        //Keys are unknown for the system title.
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    CGXDLMSBatchKeys& keys = it->second;
+    cipher->SetSecuritySuite(keys.m_BlockCipherKey.GetSize() == 32 ?
+        DLMS_SECURITY_SUITE_V2 : DLMS_SECURITY_SUITE_V0);
+    if ((ret = cipher->SetBlockCipherKey(keys.m_BlockCipherKey)) != 0 ||
+        (ret = cipher->SetAuthenticationKey(keys.m_AuthenticationKey)) != 0)
+    {
+        return ret;
+    }
+    CGXByteBuffer* key = &keys.m_BlockCipherKey;
+    if (IsDedicated(cmd))
+    {
+        if (keys.m_DedicatedKey.GetSize() == 0)
+        {
+            //Dedicated key is unknown for the system title.
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+        key = &keys.m_DedicatedKey;
+    }
+    if ((ret = cipher->Decrypt(*title, *key, data, item.m_Security,
+        item.m_SecuritySuite, item.m_InvocationCounter)) != 0)
+    {
+        return ret;
+    }
+    if ((ret = item.m_PlainText.Set(&data, data.GetPosition(), data.Available())) != 0)
+    {
+        return ret;
+    }
+    //Decode the plain APDU as it would be received without ciphering.
+    CGXReplyData reply;
+    settings.ResetBlockIndex();
+    cipher->SetSecurity(item.m_Security);
+    ret = CGXDLMS::GetData(settings, item.m_PlainText, reply, NULL);
+    item.m_PlainText.SetPosition(0);
+    item.m_Command = reply.GetCommand();
+    if (ret == 0)
+    {
+        item.m_Value = reply.GetValue();
+    }
+    return ret;
+}
+
+void CGXDLMSBatchDecoder::DecodeRange(CGXDLMSBatchWork& work)
+{
+    CGXDLMSSettings settings(false);
+    CGXByteBuffer systemTitle;
+    CGXCipher cipher(systemTitle);
+    settings.SetInterfaceType(DLMS_INTERFACE_TYPE_PDU);
+    settings.SetUseLogicalNameReferencing(m_UseLogicalNameReferencing);
+    settings.SetCipher(&cipher);
+    std::vector<CGXDLMSBatchItem>& items = *work.m_Items;
+    for (size_t pos = work.m_Index; pos < items.size(); pos += work.m_Step)
+    {
+        items[pos].m_Error = Decode(settings, items[pos]);
+    }
+    settings.SetCipher(NULL);
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+unsigned int __stdcall CGXDLMSBatchDecoder::Worker(void* parameter)
+{
+    CGXDLMSBatchWork* work = (CGXDLMSBatchWork*)parameter;
+    work->m_Decoder->DecodeRange(*work);
+    return 0;
+}
+#else
+void* CGXDLMSBatchDecoder::Worker(void* parameter)
+{
+    CGXDLMSBatchWork* work = (CGXDLMSBatchWork*)parameter;
+    work->m_Decoder->DecodeRange(*work);
+    return NULL;
+}
+#endif //defined(_WIN32) || defined(_WIN64)
+
+/**
+* Returns amount of available processors.
+*/
+static int GetProcessorCount()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#elif defined(__linux__)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (int)count;
+#else
+    return 1;
+#endif //defined(_WIN32) || defined(_WIN64)
+}
+
+int CGXDLMSBatchDecoder::Decode(std::vector<CGXDLMSBatchItem>& items)
+{
+    size_t pos, count = m_ThreadCount > 0 ? (size_t)m_ThreadCount : (size_t)GetProcessorCount();
+    if (count > items.size())
+    {
+        count = items.size();
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+    //Items are divided between the workers so that each worker handles
+    //every count item. Results are written in place and the order is kept.
+    std::vector<CGXDLMSBatchWork> works(count);
+    for (pos = 0; pos != count; ++pos)
+    {
+        works[pos].m_Decoder = this;
+        works[pos].m_Items = &items;
+        works[pos].m_Index = pos;
+        works[pos].m_Step = count;
+    }
+#if defined(_WIN32) || defined(_WIN64)
+    std::vector<HANDLE> threads;
+    for (pos = 1; pos < count; ++pos)
+    {
+        HANDLE h = (HANDLE)_beginthreadex(NULL, 0, Worker, &works[pos], 0, NULL);
+        if (h == 0)
+        {
+            //Thread can't create. Work is done by the caller.
+            DecodeRange(works[pos]);
+        }
+        else
+        {
+            threads.push_back(h);
+        }
+    }
+    DecodeRange(works[0]);
+    for (std::vector<HANDLE>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        WaitForSingleObject(*it, INFINITE);
+        CloseHandle(*it);
+    }
+#elif defined(__linux__)
+    std::vector<pthread_t> threads;
+    for (pos = 1; pos < count; ++pos)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, Worker, &works[pos]) != 0)
+        {
+            //Thread can't create. Work is done by the caller.
+            DecodeRange(works[pos]);
+        }
+        else
+        {
+            threads.push_back(thread);
+        }
+    }
+    DecodeRange(works[0]);
+    for (std::vector<pthread_t>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        pthread_join(*it, NULL);
+    }
+#else
+    for (pos = 1; pos < count; ++pos)
+    {
+        DecodeRange(works[pos]);
+    }
+    DecodeRange(works[0]);
+#endif //defined(_WIN32) || defined(_WIN64)
+    return 0;
+}
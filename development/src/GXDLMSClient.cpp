@@ -1041,10 +1041,18 @@ int CGXDLMSClient::ParseApplicationAssociationResponse(
                     m_Settings.GetCtoSChallenge().GetSize());
                 tmp2.Set(m_Settings.GetStoCChallenge().GetData(),
                     m_Settings.GetStoCChallenge().GetSize());
-                CGXEcdsa sig(m_Settings.GetCipher()->GetSigningKeyPair().first);
                 CGXByteBuffer bb;
                 bb.Set(value.byteArr, value.GetSize());
-                ret = sig.Verify(bb, tmp2, equals);
+                if (m_Settings.GetCipher()->GetCertificateCache() != NULL)
+                {
+                    ret = m_Settings.GetCipher()->GetCertificateCache()->Verify(
+                        m_Settings.GetCipher()->GetSigningKeyPair().first, bb, tmp2, equals);
+                }
+                else
+                {
+                    CGXEcdsa sig(m_Settings.GetCipher()->GetSigningKeyPair().first);
+                    ret = sig.Verify(bb, tmp2, equals);
+                }
                 m_Settings.SetConnected((DLMS_CONNECTION_STATE)(m_Settings.GetConnected() | DLMS_CONNECTION_STATE_DLMS));
             }
             else
@@ -1681,12 +1689,33 @@ int CGXDLMSClient::Write(CGXDLMSVariant& name,
     return Write(name, objectType, index, data, &param, reply);
 }
 
-int CGXDLMSClient::Write(CGXDLMSVariant& name, 
+int CGXDLMSClient::Write(CGXDLMSVariant& name,
     DLMS_OBJECT_TYPE objectType,
-    int index, 
+    int index,
     CGXByteBuffer& value,
     CGXByteBuffer* parameters,
     std::vector<CGXByteBuffer>& reply)
+{
+    return Write(name, objectType, index, value, parameters, &reply, NULL);
+}
+
+int CGXDLMSClient::Write(CGXDLMSVariant& name,
+    DLMS_OBJECT_TYPE objectType,
+    int index,
+    CGXByteBuffer& value,
+    CGXByteBuffer* parameters,
+    CGXDLMSFrameWriter& writer)
+{
+    return Write(name, objectType, index, value, parameters, NULL, &writer);
+}
+
+int CGXDLMSClient::Write(CGXDLMSVariant& name,
+    DLMS_OBJECT_TYPE objectType,
+    int index,
+    CGXByteBuffer& value,
+    CGXByteBuffer* parameters,
+    std::vector<CGXByteBuffer>* reply,
+    CGXDLMSFrameWriter* writer)
 {
     int ret;
     CGXByteBuffer bb;
@@ -1721,7 +1750,14 @@ int CGXDLMSClient::Write(CGXDLMSVariant& name,
         CGXDLMSLNParameters p(&m_Settings, 0,
             DLMS_COMMAND_SET_REQUEST, DLMS_SET_COMMAND_TYPE_NORMAL,
             &bb, &value, 0xff, DLMS_COMMAND_NONE);
-        ret = CGXDLMS::GetLnMessages(p, reply);
+        if (writer != NULL)
+        {
+            ret = CGXDLMS::GetLnMessages(p, *writer);
+        }
+        else
+        {
+            ret = CGXDLMS::GetLnMessages(p, *reply);
+        }
     }
     else
     {
@@ -1735,7 +1771,14 @@ int CGXDLMSClient::Write(CGXDLMSVariant& name,
             DLMS_COMMAND_WRITE_REQUEST, 1,
             DLMS_VARIABLE_ACCESS_SPECIFICATION_VARIABLE_NAME,
             &bb, &value);
-        ret = CGXDLMS::GetSnMessages(p, reply);
+        if (writer != NULL)
+        {
+            ret = CGXDLMS::GetSnMessages(p, *writer);
+        }
+        else
+        {
+            ret = CGXDLMS::GetSnMessages(p, *reply);
+        }
     }
     return ret;
 }
@@ -1935,6 +1978,27 @@ int CGXDLMSClient::Method(
     int index,
     CGXByteBuffer& value,
     std::vector<CGXByteBuffer>& reply)
+{
+    return Method(name, objectType, index, value, &reply, NULL);
+}
+
+int CGXDLMSClient::Method(
+    CGXDLMSVariant name,
+    DLMS_OBJECT_TYPE objectType,
+    int index,
+    CGXByteBuffer& value,
+    CGXDLMSFrameWriter& writer)
+{
+    return Method(name, objectType, index, value, NULL, &writer);
+}
+
+int CGXDLMSClient::Method(
+    CGXDLMSVariant name,
+    DLMS_OBJECT_TYPE objectType,
+    int index,
+    CGXByteBuffer& value,
+    std::vector<CGXByteBuffer>* reply,
+    CGXDLMSFrameWriter* writer)
 {
     int ret;
     if (index < 1)
@@ -1959,7 +2023,14 @@ int CGXDLMSClient::Method(
         CGXDLMSLNParameters p(&m_Settings, 0,
             DLMS_COMMAND_METHOD_REQUEST, DLMS_ACTION_COMMAND_TYPE_NORMAL,
             &bb, &value, 0xff, DLMS_COMMAND_NONE);
-        ret = CGXDLMS::GetLnMessages(p, reply);
+        if (writer != NULL)
+        {
+            ret = CGXDLMS::GetLnMessages(p, *writer);
+        }
+        else
+        {
+            ret = CGXDLMS::GetLnMessages(p, *reply);
+        }
     }
     else
     {
@@ -1989,7 +2060,14 @@ int CGXDLMSClient::Method(
         bb.SetUInt8(1);
         CGXDLMSSNParameters p(&m_Settings, DLMS_COMMAND_READ_REQUEST, 1,
             requestType, &bb, &value);
-        ret = CGXDLMS::GetSnMessages(p, reply);
+        if (writer != NULL)
+        {
+            ret = CGXDLMS::GetSnMessages(p, *writer);
+        }
+        else
+        {
+            ret = CGXDLMS::GetSnMessages(p, *reply);
+        }
     }
     return ret;
 }
@@ -344,4 +344,43 @@ int CGXDLMSCompactData::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     return DLMS_ERROR_CODE_OK;
 }
 
+int CGXDLMSCompactData::Produce(
+    CGXDLMSSettings& settings,
+    CGXDLMSValueEventArg& e,
+    unsigned long size,
+    CGXByteBuffer& data,
+    bool& completed)
+{
+    int ret;
+    unsigned long pos = e.GetProducerPosition();
+    if (e.GetIndex() != 2 || pos > m_Buffer.GetSize())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    unsigned long count = m_Buffer.GetSize() - pos;
+    //Add type and length only for the first time.
+    if (pos == 0)
+    {
+        unsigned long header = data.GetSize();
+        if ((ret = data.SetUInt8(DLMS_DATA_TYPE_OCTET_STRING)) != 0 ||
+            (ret = GXHelpers::SetObjectCount(m_Buffer.GetSize(), data)) != 0)
+        {
+            return ret;
+        }
+        header = data.GetSize() - header;
+        size = size > header ? size - header : 1;
+    }
+    if (count > size)
+    {
+        count = size;
+    }
+    if ((ret = data.Set(m_Buffer.GetData() + pos, count)) != 0)
+    {
+        return ret;
+    }
+    e.SetProducerPosition(pos + count);
+    completed = pos + count == m_Buffer.GetSize();
+    return 0;
+}
+
 #endif //DLMS_IGNORE_COMPACT_DATA
\ No newline at end of file
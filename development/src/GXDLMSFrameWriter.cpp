@@ -0,0 +1,177 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#include "../include/GXDLMSFrameWriter.h"
+
+CGXDLMSFrameWriter::CGXDLMSFrameWriter() : m_PduCount(0)
+{
+}
+
+CGXDLMSFrameWriter::~CGXDLMSFrameWriter()
+{
+    for (std::vector<CGXByteBuffer*>::iterator it = m_Pdus.begin(); it != m_Pdus.end(); ++it)
+    {
+        delete *it;
+    }
+}
+
+long CGXDLMSFrameWriter::NewPdu()
+{
+    if (m_PduCount == m_Pdus.size())
+    {
+        m_Pdus.push_back(new CGXByteBuffer());
+    }
+    else
+    {
+        m_Pdus[m_PduCount]->Clear();
+    }
+    return (long)m_PduCount++;
+}
+
+void CGXDLMSFrameWriter::NewFrame()
+{
+    m_Frames.push_back((unsigned long)m_Segments.size());
+}
+
+void CGXDLMSFrameWriter::AddSegment(long source, unsigned long offset, unsigned long size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    // Header and trailer of the frame are joined if they are next to each other.
+    if (m_Segments.size() > m_Frames.back())
+    {
+        CGXSegment& last = m_Segments.back();
+        if (last.m_Source == source && last.m_Offset + last.m_Size == offset)
+        {
+            last.m_Size += size;
+            return;
+        }
+    }
+    CGXSegment s;
+    s.m_Source = source;
+    s.m_Offset = offset;
+    s.m_Size = size;
+    m_Segments.push_back(s);
+}
+
+void CGXDLMSFrameWriter::Clear()
+{
+    m_PduCount = 0;
+    m_Headers.Clear();
+    m_Segments.clear();
+    m_Frames.clear();
+}
+
+unsigned long CGXDLMSFrameWriter::GetCount()
+{
+    return (unsigned long)m_Frames.size();
+}
+
+unsigned long CGXDLMSFrameWriter::GetSegmentCount(unsigned long index)
+{
+    if (index >= m_Frames.size())
+    {
+        return 0;
+    }
+    if (index + 1 == m_Frames.size())
+    {
+        return (unsigned long)m_Segments.size() - m_Frames[index];
+    }
+    return m_Frames[index + 1] - m_Frames[index];
+}
+
+unsigned long CGXDLMSFrameWriter::GetSize(unsigned long index)
+{
+    unsigned long size = 0, count = GetSegmentCount(index);
+    for (unsigned long pos = 0; pos != count; ++pos)
+    {
+        size += m_Segments[m_Frames[index] + pos].m_Size;
+    }
+    return size;
+}
+
+const unsigned char* CGXDLMSFrameWriter::GetSegment(
+    unsigned long index,
+    unsigned long segment,
+    unsigned long& size)
+{
+    if (segment >= GetSegmentCount(index))
+    {
+        size = 0;
+        return NULL;
+    }
+    CGXSegment& s = m_Segments[m_Frames[index] + segment];
+    size = s.m_Size;
+    if (s.m_Source == -1)
+    {
+        return m_Headers.GetData() + s.m_Offset;
+    }
+    return m_Pdus[s.m_Source]->GetData() + s.m_Offset;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+int CGXDLMSFrameWriter::GetFrame(unsigned long index, struct iovec* vec)
+{
+    unsigned long size, count = GetSegmentCount(index);
+    for (unsigned long pos = 0; pos != count; ++pos)
+    {
+        vec[pos].iov_base = (void*)GetSegment(index, pos, size);
+        vec[pos].iov_len = size;
+    }
+    return (int)count;
+}
+#endif
+
+int CGXDLMSFrameWriter::GetFrame(unsigned long index, CGXByteBuffer& frame)
+{
+    int ret;
+    const unsigned char* data;
+    unsigned long size, count = GetSegmentCount(index);
+    if (count == 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    frame.Clear();
+    for (unsigned long pos = 0; pos != count; ++pos)
+    {
+        data = GetSegment(index, pos, size);
+        if ((ret = frame.Set(data, size)) != 0)
+        {
+            return ret;
+        }
+    }
+    return 0;
+}
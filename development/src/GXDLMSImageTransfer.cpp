@@ -213,13 +213,54 @@ int CGXDLMSImageTransfer::ImageBlockTransfer(CGXDLMSClient* client, CGXByteBuffe
     {
         imageBlockCount = (unsigned long)blocks.size();
         CGXDLMSVariant tmp;
+        std::vector<CGXByteBuffer> messages;
         for (std::vector<CGXByteBuffer>::iterator it = blocks.begin(); it != blocks.end(); ++it)
         {
             tmp = *it;
-            if ((ret = client->Method(this, 2, tmp, DLMS_DATA_TYPE_ARRAY, reply)) != 0)
+            //Method clears the messages. Frames of each block are appended to the reply.
+            if ((ret = client->Method(this, 2, tmp, DLMS_DATA_TYPE_ARRAY, messages)) != 0)
             {
                 break;
             }
+            reply.insert(reply.end(), messages.begin(), messages.end());
+        }
+    }
+    return ret;
+}
+
+int CGXDLMSImageTransfer::ImageBlockTransfer(CGXDLMSClient* client, CGXByteBuffer& image, unsigned long& imageBlockCount, CGXDLMSFrameWriter& writer)
+{
+    int ret = 0;
+    if (m_ImageBlockSize == 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    unsigned long size, cnt = (unsigned long)(image.GetSize() / m_ImageBlockSize);
+    if (image.GetSize() % m_ImageBlockSize != 0)
+    {
+        ++cnt;
+    }
+    imageBlockCount = cnt;
+    CGXDLMSVariant name = GetName();
+    CGXByteBuffer data;
+    for (unsigned long pos = 0; pos != cnt; ++pos)
+    {
+        size = image.GetSize() - pos * m_ImageBlockSize;
+        if (size > m_ImageBlockSize)
+        {
+            size = m_ImageBlockSize;
+        }
+        data.Clear();
+        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+        data.SetUInt8(2);
+        data.SetUInt8(DLMS_DATA_TYPE_UINT32);
+        data.SetUInt32(pos);
+        data.SetUInt8(DLMS_DATA_TYPE_OCTET_STRING);
+        GXHelpers::SetObjectCount(size, data);
+        data.Set(image.GetData() + pos * m_ImageBlockSize, size);
+        if ((ret = client->Method(name, GetObjectType(), 2, data, writer)) != 0)
+        {
+            break;
         }
     }
     return ret;
@@ -40,6 +40,8 @@
 #include "../include/GXDLMSObjectFactory.h"
 #include "../include/GXDLMSSecuritySetup.h"
 #include "../include/GXDLMSAccessItem.h"
+#include "../include/GXDLMSCompactData.h"
+#include "../include/GXDLMSAssociationLogicalName.h"
 
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
 void AppendAttributeDescriptor(CGXDLMSTranslatorStructure* xml, int ci, unsigned char* ln, unsigned char attributeIndex)
@@ -81,6 +83,40 @@ void AppendMethodDescriptor(CGXDLMSTranslatorStructure* xml, int ci, unsigned ch
 }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
 
+// Returns producer if attribute value is serialized in parts.
+static IGXDLMSValueProducer* GetProducer(CGXDLMSObject* obj, unsigned char attributeIndex)
+{
+#ifndef DLMS_IGNORE_COMPACT_DATA
+    if (obj->GetObjectType() == DLMS_OBJECT_TYPE_COMPACT_DATA && attributeIndex == 2)
+    {
+        return (CGXDLMSCompactData*)obj;
+    }
+#endif //DLMS_IGNORE_COMPACT_DATA
+#ifndef DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+    if (obj->GetObjectType() == DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME && attributeIndex == 2)
+    {
+        return (CGXDLMSAssociationLogicalName*)obj;
+    }
+#endif //DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+    return NULL;
+}
+
+// Serialize next part of the value. Producer is removed when the whole value is serialized.
+static int Produce(
+    CGXDLMSSettings& settings,
+    CGXDLMSValueEventArg* e,
+    unsigned long size,
+    CGXByteBuffer& data)
+{
+    int ret;
+    bool completed = false;
+    if ((ret = e->GetProducer()->Produce(settings, *e, size, data, completed)) == 0 && completed)
+    {
+        e->SetProducer(NULL);
+    }
+    return ret;
+}
+
 int CGXDLMSLNCommandHandler::GetRequestNormal(
     CGXDLMSSettings& settings,
     unsigned char invokeID,
@@ -96,7 +132,6 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
     settings.SetCount(0);
     settings.SetIndex(0);
     settings.ResetBlockIndex();
-    CGXDLMSValueEventCollection arr;
     unsigned char attributeIndex;
     unsigned char* ln;
     // CI
@@ -167,9 +202,9 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
         GXHelpers::GetLogicalName(ln, name);
         obj = server->FindObject(ci, 0, name);
     }
-    CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, obj, attributeIndex, selector, parameters);
+    CGXDLMSValueEventCollection arr(&server->m_EventPool);
+    CGXDLMSValueEventArg* e = arr.Add(server, obj, attributeIndex, selector, &parameters);
     e->SetInvokeId(invokeID);
-    arr.push_back(e);
     if (obj == NULL)
     {
         // "Access Error : Device reports a undefined object."
@@ -186,38 +221,64 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
         {
             if (obj->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC && attributeIndex == 2)
             {
-                e->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)obj));
+                e->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)obj, 0, 0, settings.GetMaxPduSize()));
             }
             server->PreRead(arr);
-            if (!e->GetHandled())
+            if (e->GetProducer() == NULL && !e->GetHandled())
             {
-                settings.SetCount(e->GetRowEndIndex() - e->GetRowBeginIndex());
-                if ((ret = obj->GetValue(settings, *e)) != 0)
+                e->SetProducer(GetProducer(obj, attributeIndex));
+            }
+            if (e->GetProducer() != NULL)
+            {
+                // Only the first block of the value is serialized.
+                // Rest of the value is produced when next block is asked.
+                bool handled = e->GetHandled();
+                if ((ret = Produce(settings, e, settings.GetMaxPduSize(), bb)) != 0)
                 {
                     status = DLMS_ERROR_CODE_HARDWARE_FAULT;
                 }
-                server->PostRead(arr);
-            }
-            if (status == 0)
-            {
-                status = e->GetError();
-            }
-            CGXDLMSVariant& value = e->GetValue();
-            if (e->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
-            {
-                // If byte array is added do not add type.
-                bb.Set(value.byteArr, value.GetSize());
+                if (!handled)
+                {
+                    server->PostRead(arr);
+                }
+                if (status == 0)
+                {
+                    status = e->GetError();
+                }
             }
-            else if ((ret = CGXDLMS::AppendData(&settings, obj, attributeIndex, bb, value)) != 0)
+            else
             {
-                status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                if (!e->GetHandled())
+                {
+                    settings.SetCount(e->GetRowEndIndex() - e->GetRowBeginIndex());
+                    if ((ret = obj->GetValue(settings, *e)) != 0)
+                    {
+                        status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                    }
+                    server->PostRead(arr);
+                }
+                if (status == 0)
+                {
+                    status = e->GetError();
+                }
+                CGXDLMSVariant& value = e->GetValue();
+                if (e->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+                {
+                    // If byte array is added do not add type.
+                    bb.Set(value.byteArr, value.GetSize());
+                }
+                else if ((ret = CGXDLMS::AppendData(&settings, obj, attributeIndex, bb, value)) != 0)
+                {
+                    status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                }
             }
         }
     }
     CGXDLMSLNParameters p(&settings, invokeID, DLMS_COMMAND_GET_RESPONSE, 1, NULL, &bb, status, cipheredCommand);
     ret = CGXDLMS::GetLNPdu(p, *replyData);
     if (settings.GetCount() != settings.GetIndex()
-        || bb.GetSize() != bb.GetPosition())
+        || bb.GetSize() != bb.GetPosition()
+        || (status == 0 && e->GetProducer() != NULL))
     {
         if (server->m_Transaction != NULL)
         {
@@ -225,6 +286,7 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
             server->m_Transaction = NULL;
         }
         server->m_Transaction = new CGXDLMSLongTransaction(arr, DLMS_COMMAND_GET_REQUEST, bb);
+        server->m_Transaction->SetSize(bb.GetSize());
     }
     return ret;
 }
@@ -237,6 +299,7 @@ int CGXDLMSLNCommandHandler::GetRequestNextDataBlock(
     CGXByteBuffer* replyData,
     CGXDLMSTranslatorStructure* xml,
     bool streaming,
+    bool moreBlocks,
     unsigned char cipheredCommand)
 {
     CGXByteBuffer bb;
@@ -270,7 +333,7 @@ int CGXDLMSLNCommandHandler::GetRequestNextDataBlock(
     CGXDLMSLNParameters p(&settings, invokeID,
         streaming ? DLMS_COMMAND_GENERAL_BLOCK_TRANSFER : DLMS_COMMAND_GET_RESPONSE,
         2, NULL, &bb, DLMS_ERROR_CODE_OK, cipheredCommand);
-    p.SetStreaming(streaming);
+    p.SetStreaming(streaming && moreBlocks);
     p.SetWindowSize(settings.GetGbtWindowSize());
     // If m_Transaction is not in progress.
     if (server->m_Transaction == NULL)
@@ -281,44 +344,71 @@ int CGXDLMSLNCommandHandler::GetRequestNextDataBlock(
     {
         bb.Set(&server->m_Transaction->GetData());
         unsigned char moreData = settings.GetIndex() != settings.GetCount();
-        if (moreData)
+        if (server->m_Transaction->IsProducing())
         {
-            // If there is multiple blocks on the buffer.
-            // This might happen when Max PDU size is very small.
-            if (bb.GetSize() < settings.GetMaxPduSize())
+            // Next part of the value is produced to fill the PDU.
+            for (std::vector<CGXDLMSValueEventArg*>::iterator arg = server->m_Transaction->GetTargets().begin();
+                arg != server->m_Transaction->GetTargets().end(); ++arg)
             {
-                CGXDLMSVariant value;
-                for (std::vector<CGXDLMSValueEventArg*>::iterator arg = server->m_Transaction->GetTargets().begin();
-                    arg != server->m_Transaction->GetTargets().end(); ++arg)
+                if ((*arg)->GetProducer() != NULL && bb.GetSize() < settings.GetMaxPduSize() &&
+                    (ret = Produce(settings, *arg, settings.GetMaxPduSize() - bb.GetSize(), bb)) != 0)
                 {
-                    server->PreRead(server->m_Transaction->GetTargets());
-                    if (!(*arg)->GetHandled())
-                    {
-                        if ((ret = (*arg)->GetTarget()->GetValue(settings, *(*arg))) != 0)
-                        {
-                            return ret;
-                        }
-                        std::vector<CGXDLMSValueEventArg*> arr;
-                        arr.push_back(*arg);
-                        server->PostRead(arr);
-                    }
-                    value = (*arg)->GetValue();
-                    // Add data.
-                    if ((*arg)->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
-                    {
-                        // If byte array is added do not add type.
-                        bb.Set(value.byteArr, value.GetSize());
-                    }
-                    else if ((ret = CGXDLMS::AppendData(&settings, (*arg)->GetTarget(), (*arg)->GetIndex(), bb, value)) != 0)
+                    return ret;
+                }
+            }
+            moreData = false;
+        }
+        // Values are added until the PDU is full.
+        // There might be multiple blocks on the buffer when Max PDU size is very small.
+        while (moreData && bb.GetSize() < settings.GetMaxPduSize())
+        {
+            unsigned short index = settings.GetIndex();
+            CGXDLMSVariant value;
+            for (std::vector<CGXDLMSValueEventArg*>::iterator arg = server->m_Transaction->GetTargets().begin();
+                arg != server->m_Transaction->GetTargets().end(); ++arg)
+            {
+                CGXDLMSObject* obj = (*arg)->GetTarget();
+                if (obj != NULL && obj->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC && (*arg)->GetIndex() == 2)
+                {
+                    //Rows per PDU is counted from the size of the rows that are already serialized.
+                    (*arg)->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)obj,
+                        index, server->m_Transaction->GetSize(), settings.GetMaxPduSize() - bb.GetSize()));
+                }
+                server->PreRead(server->m_Transaction->GetTargets());
+                if (!(*arg)->GetHandled())
+                {
+                    if ((ret = (*arg)->GetTarget()->GetValue(settings, *(*arg))) != 0)
                     {
-                        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+                        return ret;
                     }
+                    std::vector<CGXDLMSValueEventArg*> arr;
+                    arr.push_back(*arg);
+                    server->PostRead(arr);
+                }
+                value = (*arg)->GetValue();
+                unsigned long size = bb.GetSize();
+                // Add data.
+                if ((*arg)->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+                {
+                    // If byte array is added do not add type.
+                    bb.Set(value.byteArr, value.GetSize());
+                }
+                else if ((ret = CGXDLMS::AppendData(&settings, (*arg)->GetTarget(), (*arg)->GetIndex(), bb, value)) != 0)
+                {
+                    return DLMS_ERROR_CODE_HARDWARE_FAULT;
                 }
+                server->m_Transaction->SetSize(server->m_Transaction->GetSize() + bb.GetSize() - size);
+            }
+            moreData = settings.GetIndex() != settings.GetCount();
+            //Stop if there are no new rows.
+            if (settings.GetIndex() == index)
+            {
+                break;
             }
         }
         p.SetMultipleBlocks(true);
         ret = CGXDLMS::GetLNPdu(p, *replyData);
-        moreData = settings.GetIndex() != settings.GetCount();
+        moreData = settings.GetIndex() != settings.GetCount() || server->m_Transaction->IsProducing();
         if (moreData || bb.GetSize() - bb.GetPosition() != 0)
         {
             server->m_Transaction->SetData(bb);
@@ -342,7 +432,7 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
     CGXDLMSTranslatorStructure* xml,
     unsigned char cipheredCommand)
 {
-    CGXDLMSValueEventCollection list;
+    CGXDLMSValueEventCollection list(server != NULL ? &server->m_EventPool : NULL);
     CGXByteBuffer bb;
     int ret;
     unsigned char attributeIndex;
@@ -426,14 +516,12 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
             if (obj == NULL)
             {
                 // Access Error : Device reports a undefined object.
-                CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, obj, attributeIndex);
+                CGXDLMSValueEventArg* e = list.Add(server, obj, attributeIndex);
                 e->SetError(DLMS_ERROR_CODE_UNDEFINED_OBJECT);
-                list.push_back(e);
             }
             else
             {
-                CGXDLMSValueEventArg* arg = new CGXDLMSValueEventArg(server, obj, attributeIndex, selector, parameters);
-                list.push_back(arg);
+                CGXDLMSValueEventArg* arg = list.Add(server, obj, attributeIndex, selector, &parameters);
                 if (server->GetAttributeAccess(arg) == DLMS_ACCESS_MODE_NONE)
                 {
                     // Read Write denied.
@@ -450,11 +538,15 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
     }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
     server->PreRead(list);
-    pos = 0;
+    bool moreData = false;
     for (std::vector<CGXDLMSValueEventArg*>::iterator it = list.begin(); it != list.end(); ++it)
     {
         if (!(*it)->GetHandled())
         {
+            //Each value is serialized at once because the targets are not read again.
+            settings.SetCount(0);
+            settings.SetIndex(0);
+            (*it)->SetSkipMaxPduSize(true);
             ret = (*it)->GetTarget()->GetValue(settings, *(*it));
         }
         CGXDLMSVariant& value = (*it)->GetValue();
@@ -470,17 +562,21 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
         }
         if (settings.GetIndex() != settings.GetCount())
         {
-            if (server->m_Transaction != NULL)
-            {
-                delete server->m_Transaction;
-                server->m_Transaction = NULL;
-            }
-            CGXByteBuffer empty;
-            server->m_Transaction = new CGXDLMSLongTransaction(list, DLMS_COMMAND_GET_REQUEST, empty);
+            moreData = true;
         }
-        ++pos;
     }
     server->PostRead(list);
+    //Transaction is created after the loop because it takes the arguments from the list.
+    if (moreData)
+    {
+        if (server->m_Transaction != NULL)
+        {
+            delete server->m_Transaction;
+            server->m_Transaction = NULL;
+        }
+        CGXByteBuffer empty;
+        server->m_Transaction = new CGXDLMSLongTransaction(list, DLMS_COMMAND_GET_REQUEST, empty);
+    }
     CGXDLMSLNParameters p(&settings, invokeID, DLMS_COMMAND_GET_RESPONSE, 3, NULL, &bb, 0xFF, cipheredCommand);
     return CGXDLMS::GetLNPdu(p, *replyData);
 }
@@ -532,7 +628,7 @@ int CGXDLMSLNCommandHandler::HandleGetRequest(
     else if (type == DLMS_GET_COMMAND_TYPE_NEXT_DATA_BLOCK)
     {
         // Get request for next data block
-        ret = GetRequestNextDataBlock(settings, invokeID, server, data, replyData, xml, false, cipheredCommand);
+        ret = GetRequestNextDataBlock(settings, invokeID, server, data, replyData, xml, false, false, cipheredCommand);
     }
     else if (type == DLMS_GET_COMMAND_TYPE_WITH_LIST)
     {
@@ -686,10 +782,9 @@ int CGXDLMSLNCommandHandler::HandleSetRequestNormal(
     }
     else
     {
-        CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, obj, index);
+        CGXDLMSValueEventCollection list(&server->m_EventPool);
+        CGXDLMSValueEventArg* e = list.Add(server, obj, index);
         e->SetValue(value);
-        CGXDLMSValueEventCollection list;
-        list.push_back(e);
         DLMS_ACCESS_MODE am = server->GetAttributeAccess(e);
         // If write is denied.
         if (am != DLMS_ACCESS_MODE_WRITE && am != DLMS_ACCESS_MODE_READ_WRITE)
@@ -1168,9 +1263,8 @@ int CGXDLMSLNCommandHandler::MethodRequestNormal(
     }
     else
     {
-        e = new CGXDLMSValueEventArg(server, obj, id, 0, parameters);
-        CGXDLMSValueEventCollection arr;
-        arr.push_back(e);
+        CGXDLMSValueEventCollection arr(&server->m_EventPool);
+        e = arr.Add(server, obj, id, 0, &parameters);
         if (server->GetMethodAccess(e) == DLMS_METHOD_ACCESS_MODE_NONE)
         {
             error = DLMS_ERROR_CODE_READ_WRITE_DENIED;
@@ -1276,7 +1370,7 @@ int CGXDLMSLNCommandHandler::MethodRequestNextBlock(
         DLMS_ACTION_REQUEST_TYPE_NEXT_BLOCK,
         NULL, &bb, DLMS_ERROR_CODE_OK, cipheredCommand);
 
-    p.SetStreaming(streaming);
+    p.SetStreaming(streaming && moreBlocks);
     p.SetWindowSize(settings.GetGbtWindowSize());
     //If transaction is not in progress.
     if (server->m_Transaction == NULL)
@@ -1326,7 +1420,7 @@ int CGXDLMSLNCommandHandler::MethodRequestNextBlock(
         }
         p.SetMultipleBlocks(true);
         ret = CGXDLMS::GetLNPdu(p, *replyData);
-        moreData = settings.GetIndex() != settings.GetCount();
+        moreData = settings.GetIndex() != settings.GetCount() || server->m_Transaction->IsProducing();
         if (moreData || bb.GetSize() - bb.GetPosition() != 0)
         {
             server->m_Transaction->SetData(bb);
@@ -1555,11 +1649,10 @@ int CGXDLMSLNCommandHandler::HandleAccessRequest(
     GXHelpers::SetObjectCount(cnt, bb);
     CGXByteBuffer results;
     GXHelpers::SetObjectCount(cnt, results);
-    CGXDLMSValueEventCollection args;
+    CGXDLMSValueEventCollection args(server != NULL ? &server->m_EventPool : NULL);
     for (unsigned long pos = 0; pos != cnt; ++pos)
     {
-        CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, NULL, 0);
-        args.push_back(e);
+        CGXDLMSValueEventArg* e = args.Add(server, NULL, 0);
         CGXDLMSVariant value;
         CGXDataInfo di;
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
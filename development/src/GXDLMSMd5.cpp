@@ -76,7 +76,7 @@ void gxmd5_II(unsigned int *a, unsigned int b, unsigned int c, unsigned int d, u
     *a = gxmd5_rotate_left(*a + gxmd5_I(b, c, d) + x + ac, s) + b;
 }
 
-void gxmd5_decode(unsigned int * output, unsigned char *input, unsigned int len)
+void gxmd5_decode(unsigned int * output, const unsigned char *input, unsigned int len)
 {
     for (unsigned int i = 0, j = 0; j < len; i++, j += 4)
     {
@@ -101,7 +101,7 @@ void CGXDLMSMD5::Encode(unsigned char * output, unsigned int *input, unsigned in
     }
 }
 
-void CGXDLMSMD5::Transform(unsigned char* block, unsigned int *state)
+void CGXDLMSMD5::Transform(const unsigned char* block, unsigned int *state)
 {
     unsigned int a = state[0], b = state[1], c = state[2], d = state[3], x[16];
     gxmd5_decode(x, block, 64);
@@ -184,78 +184,82 @@ void CGXDLMSMD5::Transform(unsigned char* block, unsigned int *state)
     state[3] += d;
 }
 
-int CGXDLMSMD5::Update(unsigned char* data, unsigned int len, unsigned char* buffer, unsigned int* count, unsigned int* state)
+CGXDLMSMD5::CGXDLMSMD5()
 {
-    unsigned int i;
-    // Number of bytes.
-    unsigned int index = count[0] / 8 % 64;
-
-    // Update number of bits
-    if ((count[0] += (len << 3)) < (len << 3))
-    {
-        count[1]++;
-    }
-    count[1] += (len >> 29);
-
-    // number of bytes we need to fill in buffer
-    unsigned int firstpart = 64 - index;
+    Init();
+}
 
+void CGXDLMSMD5::Init()
+{
+    m_State[0] = 0x67452301;
+    m_State[1] = 0xefcdab89;
+    m_State[2] = 0x98badcfe;
+    m_State[3] = 0x10325476;
+    m_Length = 0;
+}
 
-    // transform as many times as possible.
-    if (len >= firstpart)
+void CGXDLMSMD5::Update(const unsigned char* data, unsigned long size)
+{
+    unsigned long used = (unsigned long)(m_Length % 64);
+    m_Length += size;
+    if (used != 0)
     {
-        memcpy(&buffer[index], data, firstpart);
-        Transform(buffer, state);
-
-        // Transform block
-        for (i = firstpart; i + 64 <= len; i += 64)
+        unsigned long count = 64 - used;
+        if (count > size)
+        {
+            count = size;
+        }
+        memcpy(m_Buffer + used, data, count);
+        data += count;
+        size -= count;
+        if (used + count != 64)
         {
-            Transform(data + i, state);
+            return;
         }
-        index = 0;
+        Transform(m_Buffer, m_State);
     }
-    else
+    // Transform as many times as possible.
+    for (; size >= 64; size -= 64, data += 64)
     {
-        i = 0;
+        Transform(data, m_State);
     }
+    memcpy(m_Buffer, data, size);
+}
 
-    memcpy(&buffer[index], &data[i], len - i);
-    return 0;
+void CGXDLMSMD5::Update(CGXByteBuffer& data)
+{
+    Update(data.GetData() + data.GetPosition(), data.Available());
 }
 
-int CGXDLMSMD5::Encrypt(CGXByteBuffer& data, CGXByteBuffer& digest)
+int CGXDLMSMD5::Final(CGXByteBuffer& digest)
 {
-    // Bytes that didn't fit in last 64 byte chunk
-    unsigned char buffer[64];
+    unsigned char used = (unsigned char)(m_Length % 64);
     // Number of bits (lo, hi)
-    unsigned long count[2] = { 0, 0 };
-    // Digest
-    unsigned int state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
-    digest.Capacity(16);
-
-    Update(data.GetData(), data.GetSize(), buffer, (unsigned int*)&count, (unsigned int*)&state);
-
-    static unsigned char padding[64] = {
-        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-    };
-
-    // Save number of bits
-    unsigned char bits[8];
-    Encode(bits, (unsigned int*)&count, 2);
-
+    unsigned int count[2] = { (unsigned int)(m_Length << 3), (unsigned int)(m_Length >> 29) };
     // Pad out to 56 mod 64.
-    unsigned int index = count[0] / 8 % 64;
-    unsigned int padLen = (index < 56) ? (56 - index) : (120 - index);
-    Update(padding, padLen, buffer, (unsigned int*)&count, (unsigned int*)&state);
-
+    m_Buffer[used++] = 0x80;
+    if (used > 56)
+    {
+        memset(m_Buffer + used, 0, sizeof(m_Buffer) - used);
+        Transform(m_Buffer, m_State);
+        used = 0;
+    }
+    memset(m_Buffer + used, 0, 56 - used);
     // Append length (before padding)
-    Update(bits, 8, buffer, (unsigned int*)&count, (unsigned int*)&state);
-
+    Encode(m_Buffer + 56, count, 2);
+    Transform(m_Buffer, m_State);
     // Store state in digest
-    Encode(digest.GetData(), state, 4);
+    digest.SetSize(0);
+    digest.Capacity(16);
+    Encode(digest.GetData(), m_State, 4);
     digest.SetSize(16);
+    Init();
     return 0;
 }
 
+int CGXDLMSMD5::Encrypt(CGXByteBuffer& data, CGXByteBuffer& digest)
+{
+    CGXDLMSMD5 md5;
+    md5.Update(data);
+    return md5.Final(digest);
+}
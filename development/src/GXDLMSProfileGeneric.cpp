@@ -160,12 +160,18 @@ int CGXDLMSProfileGeneric::GetData(
     std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns,
     CGXByteBuffer& data)
 {
+    //Rows are in the buffer if the server doesn't read them in PreRead.
+    bool buffered = e.GetRowEndIndex() == 0;
     if (settings.GetIndex() == 0) {
         data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
-        if (e.GetRowEndIndex() != 0) {
+        if (!buffered) {
             GXHelpers::SetObjectCount(e.GetRowEndIndex() - e.GetRowBeginIndex(), data);
         }
         else {
+            if (settings.IsServer())
+            {
+                settings.SetCount((unsigned short)table.size());
+            }
             GXHelpers::SetObjectCount((unsigned long)table.size(), data);
         }
     }
@@ -182,7 +188,17 @@ int CGXDLMSProfileGeneric::GetData(
         }
         types.push_back(type);
     }
-    for (std::vector< std::vector<CGXDLMSVariant> >::iterator row = table.begin(); row != table.end(); ++row)
+    //Server continues from the row where the previous PDU ended.
+    unsigned long first = 0, rows = 0;
+    if (buffered && settings.IsServer())
+    {
+        first = settings.GetIndex();
+        if (first > table.size())
+        {
+            first = (unsigned long)table.size();
+        }
+    }
+    for (std::vector< std::vector<CGXDLMSVariant> >::iterator row = table.begin() + first; row != table.end(); ++row)
     {
         data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
         if (columns.size() == 0)
@@ -213,10 +229,16 @@ int CGXDLMSProfileGeneric::GetData(
             }
         }
         settings.SetIndex(settings.GetIndex() + 1);
+        ++rows;
+        //If PDU is full. Rest of the rows are added when the next block is asked.
+        if (settings.IsServer() && !e.GetSkipMaxPduSize() && data.GetSize() >= settings.GetMaxPduSize())
+        {
+            break;
+        }
     }
-    if (e.GetRowEndIndex() != 0)
+    if (!buffered)
     {
-        e.SetRowBeginIndex(e.GetRowBeginIndex() + (unsigned short)table.size());
+        e.SetRowBeginIndex(e.GetRowBeginIndex() + rows);
     }
     return DLMS_ERROR_CODE_OK;
 }
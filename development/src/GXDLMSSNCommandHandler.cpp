@@ -52,7 +52,7 @@ int CGXDLMSSNCommandHandler::HandleReadRequest(
     unsigned char ch;
     unsigned long cnt = 0xFF;
     DLMS_VARIABLE_ACCESS_SPECIFICATION type;
-    CGXDLMSValueEventCollection list;
+    CGXDLMSValueEventCollection list(server != NULL ? &server->m_EventPool : NULL);
     std::vector<CGXDLMSValueEventArg*> reads;
     std::vector<CGXDLMSValueEventArg*> actions;
     // If get next frame.
@@ -76,6 +76,8 @@ int CGXDLMSSNCommandHandler::HandleReadRequest(
     else
     {
         std::string str;
+        settings.SetCount(0);
+        settings.SetIndex(0);
         if ((ret = GXHelpers::GetObjectCount(data, cnt)) != 0)
         {
             return ret;
@@ -142,6 +144,7 @@ int CGXDLMSSNCommandHandler::HandleReadRequest(
         || settings.GetCount() != settings.GetIndex()))
     {
         server->m_Transaction = new CGXDLMSLongTransaction(list, DLMS_COMMAND_READ_REQUEST, bb);
+        server->m_Transaction->SetSize(bb.GetSize());
     }
     else if (server->m_Transaction != NULL)
     {
@@ -321,10 +324,9 @@ int CGXDLMSSNCommandHandler::HandleWriteRequest(
                         }
                     }
                 }
-                CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, target.GetItem(), target.GetIndex());
+                CGXDLMSValueEventCollection arr(&server->m_EventPool);
+                CGXDLMSValueEventArg* e = arr.Add(server, target.GetItem(), target.GetIndex());
                 e->SetValue(value);
-                CGXDLMSValueEventCollection arr;
-                arr.push_back(e);
                 server->PreWrite(arr);
                 DLMS_ACCESS_MODE am = server->GetAttributeAccess(e);
                 // If write is denied.
@@ -381,34 +383,12 @@ int CGXDLMSSNCommandHandler::HandleWriteRequest(
  */
 int CGXDLMSSNCommandHandler::FindSNObject(CGXDLMSServer* server, int sn, CGXSNInfo& i)
 {
-    unsigned char offset, count;
-    for (CGXDLMSObjectCollection::iterator it = server->GetItems().begin(); it != server->GetItems().end(); ++it)
+    //Objects are added after short names are updated.
+    if (!server->m_ShortNameIndex.IsUpdated(server->GetItems()))
     {
-        if (sn >= (*it)->GetShortName())
-        {
-            // If attribute is accessed.
-            if (sn < (*it)->GetShortName() + (*it)->GetAttributeCount() * 8)
-            {
-                i.SetAction(false);
-                i.SetItem(*it);
-                i.SetIndex(((sn - (*it)->GetShortName()) / 8) + 1);
-                break;
-            }
-            else
-            {
-                // If method is accessed.
-                CGXDLMS::GetActionInfo((*it)->GetObjectType(), offset, count);
-                if (sn < (*it)->GetShortName() + offset + (8 * count))
-                {
-                    i.SetItem(*it);
-                    i.SetAction(true);
-                    i.SetIndex((sn - (*it)->GetShortName() - offset) / 8 + 1);
-                    break;
-                }
-            }
-        }
+        server->m_ShortNameIndex.Update(server->GetItems());
     }
-    if (i.GetItem() == NULL)
+    if (!server->m_ShortNameIndex.Find(sn, i))
     {
         std::string ln;
         i.SetItem(server->FindObject(DLMS_OBJECT_TYPE_NONE, sn, ln));
@@ -440,6 +420,13 @@ int CGXDLMSSNCommandHandler::GetReadData(CGXDLMSSettings& settings,
     {
         if (!(*e)->GetHandled())
         {
+            if (list.size() != 1)
+            {
+                //Each value is serialized at once because the targets are not read again.
+                settings.SetCount(0);
+                settings.SetIndex(0);
+                (*e)->SetSkipMaxPduSize(true);
+            }
             // If action.
             if ((*e)->IsAction())
             {
@@ -555,9 +542,8 @@ int CGXDLMSSNCommandHandler::HandleRead(
     {
         return ret;
     }
-    CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, i.GetItem(), i.GetIndex());
+    CGXDLMSValueEventArg* e = list.Add(server, i.GetItem(), i.GetIndex());
     e->SetAction(i.IsAction());
-    list.push_back(e);
     if (type == DLMS_VARIABLE_ACCESS_SPECIFICATION_PARAMETERISED_ACCESS)
     {
         CGXDLMSVariant params;
@@ -591,7 +577,7 @@ int CGXDLMSSNCommandHandler::HandleRead(
     {
         if (e->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC && e->GetIndex() == 2)
         {
-            e->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)e->GetTarget()));
+            e->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)e->GetTarget(), 0, 0, settings.GetMaxPduSize()));
         }
         if (e->IsAction())
         {
@@ -629,15 +615,24 @@ int CGXDLMSSNCommandHandler::HandleReadBlockNumberAccess(
         settings.ResetBlockIndex();
         return ret;
     }
-    if (settings.GetIndex() != settings.GetCount()
+    // Values are added until the PDU is full.
+    while (settings.GetIndex() != settings.GetCount()
         && server->m_Transaction->GetData().GetSize() < settings.GetMaxPduSize())
     {
         std::vector<CGXDLMSValueEventArg*> reads;
         std::vector<CGXDLMSValueEventArg*> actions;
-
+        unsigned short index = settings.GetIndex();
+        unsigned long size = server->m_Transaction->GetData().GetSize();
         for (std::vector<CGXDLMSValueEventArg*>::iterator it = server->m_Transaction->GetTargets().begin();
             it != server->m_Transaction->GetTargets().end(); ++it)
         {
+            CGXDLMSObject* obj = (*it)->GetTarget();
+            if (obj != NULL && obj->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC && (*it)->GetIndex() == 2)
+            {
+                //Rows per PDU is counted from the size of the rows that are already serialized.
+                (*it)->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)obj,
+                    index, server->m_Transaction->GetSize(), settings.GetMaxPduSize() - size));
+            }
             if ((*it)->IsAction())
             {
                 actions.push_back(*it);
@@ -668,6 +663,16 @@ int CGXDLMSSNCommandHandler::HandleReadBlockNumberAccess(
         {
             server->PostAction(actions);
         }
+        if (ret != 0)
+        {
+            return ret;
+        }
+        server->m_Transaction->SetSize(server->m_Transaction->GetSize() + data2.GetSize() - size);
+        //Stop if there are no new rows.
+        if (settings.GetIndex() == index)
+        {
+            break;
+        }
     }
     settings.IncreaseBlockIndex();
     CGXByteBuffer& tmp = server->m_Transaction->GetData();
@@ -125,7 +125,12 @@ CGXDLMSServer::CGXDLMSServer(
 
 CGXDLMSServer::~CGXDLMSServer()
 {
-
+    //Transaction returns arguments to the pool.
+    if (m_Transaction != NULL)
+    {
+        delete m_Transaction;
+        m_Transaction = NULL;
+    }
 }
 
 unsigned long CGXDLMSServer::GetPushClientAddress()
@@ -368,6 +373,7 @@ int CGXDLMSServer::UpdateShortNames(bool force)
             sn = (*it)->GetShortName();
         }
     }
+    m_ShortNameIndex.Update(m_Settings.GetObjects());
     return 0;
 }
 
@@ -378,6 +384,9 @@ void CGXDLMSServer::Reset(bool connected)
         delete m_Transaction;
         m_Transaction = NULL;
     }
+    m_GbtBlocks.clear();
+    m_GbtResend = 0;
+    m_GbtCipheredCommand = 0;
     m_Settings.SetProtocolVersion(NULL);
     m_Settings.SetCount(0);
     m_Settings.SetIndex(0);
@@ -760,45 +769,64 @@ void CGXDLMSServer::GenerateConfirmedServiceError(
     data.SetUInt8(code);
 }
 
-unsigned short CGXDLMSServer::GetRowsToPdu(CGXDLMSProfileGeneric* pg)
+unsigned short CGXDLMSServer::GetRowsToPdu(
+    CGXDLMSProfileGeneric* pg,
+    unsigned long rows,
+    unsigned long size,
+    unsigned long available)
 {
     DLMS_DATA_TYPE dt;
-    int rowsize = 0;
-    // Count how many rows we can fit to one PDU.
-    for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = pg->GetCaptureObjects().begin();
-        it != pg->GetCaptureObjects().end(); ++it)
+    unsigned long rowsize = 0;
+    if (rows != 0)
     {
-        it->first->GetDataType(it->second->GetAttributeIndex(), dt);
-        if (dt == DLMS_DATA_TYPE_OCTET_STRING)
+        //Use average size of the serialized rows.
+        rowsize = size / rows;
+    }
+    else
+    {
+        //Structure tag and count.
+        rowsize = 2;
+        for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = pg->GetCaptureObjects().begin();
+            it != pg->GetCaptureObjects().end(); ++it)
         {
-            it->first->GetUIDataType(it->second->GetAttributeIndex(), dt);
-            if (dt == DLMS_DATA_TYPE_DATETIME)
+            //Data type tag.
+            ++rowsize;
+            it->first->GetDataType(it->second->GetAttributeIndex(), dt);
+            if (dt == DLMS_DATA_TYPE_OCTET_STRING)
             {
-                rowsize += GXHelpers::GetDataTypeSize(DLMS_DATA_TYPE_DATETIME);
+                it->first->GetUIDataType(it->second->GetAttributeIndex(), dt);
+                if (dt == DLMS_DATA_TYPE_DATETIME || dt == DLMS_DATA_TYPE_DATE || dt == DLMS_DATA_TYPE_TIME)
+                {
+                    //Length and the value.
+                    rowsize += 1 + GXHelpers::GetDataTypeSize(dt);
+                }
+                else
+                {
+                    rowsize += 2;
+                }
             }
-            else if (dt == DLMS_DATA_TYPE_DATE)
+            else if (GXHelpers::GetDataTypeSize(dt) < 1)
             {
-                rowsize += GXHelpers::GetDataTypeSize(DLMS_DATA_TYPE_DATE);
+                //Size of unknown or variable length types is guessed.
+                rowsize += 2;
             }
-            else if (dt == DLMS_DATA_TYPE_TIME)
+            else
             {
-                rowsize += GXHelpers::GetDataTypeSize(DLMS_DATA_TYPE_TIME);
+                rowsize += GXHelpers::GetDataTypeSize(dt);
             }
         }
-        else if (dt == DLMS_DATA_TYPE_NONE)
-        {
-            rowsize += 2;
-        }
-        else
-        {
-            rowsize += GXHelpers::GetDataTypeSize(dt);
-        }
     }
-    if (rowsize != 0)
+    if (rowsize == 0)
     {
-        return m_Settings.GetMaxPduSize() / rowsize;
+        rowsize = 1;
     }
-    return 0;
+    //One row more so the PDU is full.
+    rows = available / rowsize + 1;
+    if (rows > 0xFFFF)
+    {
+        rows = 0xFFFF;
+    }
+    return (unsigned short)rows;
 }
 
 /**
@@ -835,12 +863,42 @@ int CGXDLMSServer::HandleReleaseRequest(CGXByteBuffer& data)
     return 0;
 }
 
+void CGXDLMSServer::AcknowledgeBlocks(
+    CGXServerReply& sr,
+    unsigned char bc,
+    unsigned short blockNumber,
+    unsigned short blockNumberAck)
+{
+    // LLC bytes are before the GBT header in HDLC.
+    int offset = CGXDLMS::UseHdlc(m_Settings.GetInterfaceType()) ? 3 : 0;
+    // Blocks of the window are sent with the block number of the client.
+    m_Settings.SetBlockNumberAck(blockNumber);
+    // Remove blocks that client has received.
+    std::vector<CGXByteBuffer>::iterator it = m_GbtBlocks.begin();
+    while (it != m_GbtBlocks.end() &&
+        (unsigned short)(it->GetData()[offset + 2] << 8 | it->GetData()[offset + 3]) <= blockNumberAck)
+    {
+        ++it;
+    }
+    m_GbtBlocks.erase(m_GbtBlocks.begin(), it);
+    m_GbtResend = 0;
+    // HDLC frames are not streamed because the block might be split to several frames.
+    if (CGXDLMS::UseHdlc(m_Settings.GetInterfaceType()) || (bc & 0x3F) == 0)
+    {
+        sr.SetCount(1);
+    }
+    else
+    {
+        sr.SetCount(bc & 0x3F);
+    }
+}
+
 int CGXDLMSServer::HandleGeneralBlockTransfer(
     CGXServerReply& sr,
     CGXByteBuffer& data,
     unsigned char cipheredCommand)
 {
-    unsigned char bc;
+    unsigned char bc = 0;
     unsigned short blockNumber = 0, blockNumberAck = 0;
     if (!sr.IsStreaming())
     {
@@ -859,65 +917,94 @@ int CGXDLMSServer::HandleGeneralBlockTransfer(
                 DLMS_SERVICE_ERROR_SERVICE,
                 DLMS_SERVICE_UNSUPPORTED, m_ReplyData);
         }
-    }
-    if (m_Transaction != NULL)
-    {
-        if (m_Transaction->GetCommand() == DLMS_COMMAND_GET_REQUEST || m_Transaction->GetCommand() == DLMS_COMMAND_METHOD_REQUEST)
+        // If client acknowledges the blocks of the get or method reply.
+        if (m_Transaction != NULL ?
+            (m_Transaction->GetCommand() == DLMS_COMMAND_GET_REQUEST || m_Transaction->GetCommand() == DLMS_COMMAND_METHOD_REQUEST) :
+            (len == 0 && !m_GbtBlocks.empty()))
         {
-            // Get request for next data block
-            if (sr.GetCount() == 0)
-            {
-                m_Settings.SetBlockNumberAck(m_Settings.GetBlockNumberAck() + 1);
-                sr.SetCount((bc & 0x3F));
-            }
-            CGXDLMSLNCommandHandler::GetRequestNextDataBlock(m_Settings, 0,
-                this, data, &m_ReplyData, NULL, true, cipheredCommand);
-            if (sr.GetCount() != 0)
-            {
-                sr.SetCount(sr.GetCount() - 1);
-            }
-            if (m_Transaction == NULL)
+            AcknowledgeBlocks(sr, bc, blockNumber, blockNumberAck);
+            m_GbtCipheredCommand = cipheredCommand;
+            if (sr.IsStreaming() && m_GbtResend == m_GbtBlocks.size() && m_Transaction == NULL)
             {
+                // All blocks are already received.
                 sr.SetCount(0);
-            }
-            //Save server GBT window size to settings because sr is lost.
-            if (m_Settings.IsServer())
-            {
-                m_Settings.SetCount(sr.GetCount());
+                return 0;
             }
         }
+    }
+    if (sr.IsStreaming())
+    {
+        bool resend = m_GbtResend < m_GbtBlocks.size();
+        if (resend)
+        {
+            // Lost block is sent again.
+            CGXByteBuffer& block = m_GbtBlocks[m_GbtResend];
+            ++m_GbtResend;
+            m_ReplyData.Set(block.GetData(), block.GetSize());
+        }
         else
         {
-            m_Transaction->GetData().Set(&data);
-            // Send ACK.
-            unsigned char igonoreAck = (bc & 0x40) != 0 &&
-                (blockNumberAck * m_Settings.GetGbtWindowSize()) + 1 > blockNumber;
-            int windowSize = m_Settings.GetGbtWindowSize();
-            int bn = m_Settings.GetBlockIndex();
-            if ((bc & 0x80) != 0)
-            {
-                HandleCommand(m_Transaction->GetCommand(),
-                    m_Transaction->GetData(), sr, cipheredCommand);
-                delete m_Transaction;
-                m_Transaction = NULL;
-                igonoreAck = false;
-                windowSize = 1;
-            }
-            if (igonoreAck)
+            CGXDLMSLNCommandHandler::GetRequestNextDataBlock(m_Settings, 0,
+                this, data, &m_ReplyData, NULL, true, sr.GetCount() > 1, m_GbtCipheredCommand);
+        }
+        sr.SetCount(sr.GetCount() - 1);
+        if (m_Transaction == NULL && m_GbtResend == m_GbtBlocks.size())
+        {
+            sr.SetCount(0);
+        }
+        if (resend)
+        {
+            // Streaming bit and acknowledged block number are updated for this window.
+            unsigned char* block = m_ReplyData.GetData() + m_ReplyData.GetSize() - m_GbtBlocks[m_GbtResend - 1].GetSize();
+            if (CGXDLMS::UseHdlc(m_Settings.GetInterfaceType()))
             {
-                return false;
+                block += 3;
             }
-            m_ReplyData.SetUInt8(DLMS_COMMAND_GENERAL_BLOCK_TRANSFER);
-            m_ReplyData.SetUInt8((0x80 | windowSize));
-            m_Settings.SetBlockIndex(m_Settings.GetBlockIndex() + 1);
-            m_ReplyData.SetUInt16(bn);
-            m_ReplyData.SetUInt16(blockNumber);
-            m_ReplyData.SetUInt8(0);
+            block[1] = (unsigned char)((block[1] & 0x80) | (sr.IsStreaming() ? 0x40 : 0) | (block[1] & 0x3F));
+            block[4] = (unsigned char)(m_Settings.GetBlockNumberAck() >> 8);
+            block[5] = (unsigned char)m_Settings.GetBlockNumberAck();
+        }
+        else
+        {
+            // Block is kept until client acknowledges it.
+            m_GbtBlocks.push_back(CGXByteBuffer());
+            m_GbtBlocks.back().Set(m_ReplyData.GetData() + m_ReplyData.GetPosition(),
+                m_ReplyData.GetSize() - m_ReplyData.GetPosition());
+            m_GbtResend = (unsigned long)m_GbtBlocks.size();
         }
     }
+    else if (m_Transaction != NULL)
+    {
+        m_Transaction->GetData().Set(&data);
+        // Send ACK.
+        unsigned char igonoreAck = (bc & 0x40) != 0 &&
+            (blockNumberAck * m_Settings.GetGbtWindowSize()) + 1 > blockNumber;
+        int windowSize = m_Settings.GetGbtWindowSize();
+        int bn = m_Settings.GetBlockIndex();
+        if ((bc & 0x80) != 0)
+        {
+            HandleCommand(m_Transaction->GetCommand(),
+                m_Transaction->GetData(), sr, cipheredCommand);
+            delete m_Transaction;
+            m_Transaction = NULL;
+            igonoreAck = false;
+            windowSize = 1;
+        }
+        if (igonoreAck)
+        {
+            return false;
+        }
+        m_ReplyData.SetUInt8(DLMS_COMMAND_GENERAL_BLOCK_TRANSFER);
+        m_ReplyData.SetUInt8((0x80 | windowSize));
+        m_Settings.SetBlockIndex(m_Settings.GetBlockIndex() + 1);
+        m_ReplyData.SetUInt16(bn);
+        m_ReplyData.SetUInt16(blockNumber);
+        m_ReplyData.SetUInt8(0);
+    }
     else
     {
         data.GetUInt8(&bc);
+        m_GbtBlocks.clear();
         m_Transaction = new CGXDLMSLongTransaction((DLMS_COMMAND)bc, data);
         m_ReplyData.SetUInt8(DLMS_COMMAND_GENERAL_BLOCK_TRANSFER);
         m_ReplyData.SetUInt8((0x80 | m_Settings.GetGbtWindowSize()));
@@ -943,6 +1030,11 @@ int CGXDLMSServer::HandleCommand(
         frame = m_Settings.GetNextSend(false);
     }
     CGXDLMSConnectionEventArgs& connectionInfo = sr.GetConnectionInfo();
+    if (cmd != DLMS_COMMAND_GENERAL_BLOCK_TRANSFER && cmd != DLMS_COMMAND_NONE)
+    {
+        // Blocks of the previous GBT transfer are not sent again.
+        m_GbtBlocks.clear();
+    }
     switch (cmd)
     {
     case DLMS_COMMAND_ACCESS_REQUEST:
@@ -994,7 +1086,7 @@ int CGXDLMSServer::HandleCommand(
         frame = DLMS_COMMAND_UA;
         break;
     case DLMS_COMMAND_GENERAL_BLOCK_TRANSFER:
-        ret = HandleGeneralBlockTransfer(sr, data, m_Info.GetCipheredCommand());
+        ret = HandleGeneralBlockTransfer(sr, data, cipheredCommand);
         break;
     case DLMS_COMMAND_DISCOVER_REQUEST:
     {
@@ -1057,6 +1149,14 @@ int CGXDLMSServer::HandleRequest(
     {
         reply.Set(&sr.GetReply());
     }
+    // All blocks of the GBT window are returned in the same reply.
+    while (ret == 0 && sr.IsStreaming())
+    {
+        if ((ret = HandleRequest(sr)) == 0)
+        {
+            reply.Set(&sr.GetReply());
+        }
+    }
     return ret;
 }
 
@@ -1093,6 +1193,12 @@ int CGXDLMSServer::HandleRequest(
         //Server not Initialized.
         return DLMS_ERROR_CODE_NOT_INITIALIZED;
     }
+    if (sr.IsStreaming() && sr.GetData().GetPosition() == sr.GetData().GetSize())
+    {
+        // Next block of the GBT window is sent without a request from the client.
+        CGXByteBuffer empty;
+        return HandleCommand(DLMS_COMMAND_GENERAL_BLOCK_TRANSFER, empty, sr, m_GbtCipheredCommand);
+    }
     m_ReceivedData.Set(&sr.GetData());
     CGXByteBuffer& reply = sr.GetReply();
     bool first = m_Settings.GetServerAddress() == 0
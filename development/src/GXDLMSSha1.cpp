@@ -32,7 +32,9 @@
 // Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
 //---------------------------------------------------------------------------
 
+#include <string.h>
 #include "../include/GXDLMSSha1.h"
+#include "../include/GXDLMSShaNi.h"
 
 
 #define SHA1_ROL(value, bits) (((value) << (bits)) | (((value) & 0xffffffff) >> (32 - (bits))))
@@ -47,13 +49,13 @@
 /*
 * Hash block is a single 512-bit block.
 */
-void CGXDLMSSha1::Transform(unsigned long *block, unsigned int *digest, unsigned int *transforms)
+static void Sha1Block(uint32_t* block, uint32_t* digest)
 {
-    unsigned int a = digest[0];
-    unsigned int b = digest[1];
-    unsigned int c = digest[2];
-    unsigned int d = digest[3];
-    unsigned int e = digest[4];
+    uint32_t a = digest[0];
+    uint32_t b = digest[1];
+    uint32_t c = digest[2];
+    uint32_t d = digest[3];
+    uint32_t e = digest[4];
 
     SHA1_R0(a, b, c, d, e, 0);
     SHA1_R0(e, a, b, c, d, 1);
@@ -141,72 +143,113 @@ void CGXDLMSSha1::Transform(unsigned long *block, unsigned int *digest, unsigned
     digest[2] += c;
     digest[3] += d;
     digest[4] += e;
-
-    ++*transforms;
 }
 
-void CGXDLMSSha1::Update(CGXByteBuffer& data, unsigned int *digest, unsigned int *transforms)
+void CGXDLMSSha1::Transform(uint32_t* digest, const unsigned char* data, unsigned long blocks)
 {
-    unsigned int pos;
-    unsigned long block[16];
-    while (data.GetSize() - data.GetPosition() > 64)
+    if (CGXDLMSShaNi::IsSupported())
+    {
+        CGXDLMSShaNi::Sha1(digest, data, blocks);
+        return;
+    }
+    unsigned char pos;
+    uint32_t block[16];
+    for (; blocks != 0; --blocks, data += 64)
     {
         for (pos = 0; pos != 16; ++pos)
         {
-            data.GetUInt32(&block[pos]);
+            block[pos] = ((uint32_t)data[4 * pos] << 24) |
+                ((uint32_t)data[4 * pos + 1] << 16) |
+                ((uint32_t)data[4 * pos + 2] << 8) |
+                data[4 * pos + 3];
         }
-        Transform(block, digest, transforms);
+        Sha1Block(block, digest);
     }
 }
 
-int CGXDLMSSha1::Final(CGXByteBuffer& data, unsigned int *digest, unsigned int *transforms, CGXByteBuffer& reply)
+CGXDLMSSha1::CGXDLMSSha1()
 {
-    int pos;
-    reply.Capacity(*transforms * 64);
-    reply.Set(data.GetData(), data.GetSize());
-    /* Total number of hashed bits */
-    unsigned long long total_bits = (*transforms * 64 + data.GetSize()) * 8;
+    Init();
+}
 
-    /* Padding */
-    reply.SetUInt8(0x80);
-    unsigned int orig_size = reply.GetSize();
-    reply.Zero(reply.GetSize(), 64 - reply.GetSize());
-    unsigned long block[16];
-    for (pos = 0; pos != 16; ++pos)
-    {
-        reply.GetUInt32(&block[pos]);
-    }
-    if (orig_size > 64 - 8)
+void CGXDLMSSha1::Init()
+{
+    m_State[0] = 0x67452301;
+    m_State[1] = 0xefcdab89;
+    m_State[2] = 0x98badcfe;
+    m_State[3] = 0x10325476;
+    m_State[4] = 0xc3d2e1f0;
+    m_Length = 0;
+}
+
+void CGXDLMSSha1::Update(const unsigned char* data, unsigned long size)
+{
+    unsigned long used = (unsigned long)(m_Length % 64);
+    m_Length += size;
+    if (used != 0)
     {
-        Transform(block, digest, transforms);
-        for (pos = 0; pos < 16 - 2; ++pos)
+        unsigned long count = 64 - used;
+        if (count > size)
         {
-            block[pos] = 0;
+            count = size;
         }
+        memcpy(m_Buffer + used, data, count);
+        data += count;
+        size -= count;
+        if (used + count != 64)
+        {
+            return;
+        }
+        Transform(m_State, m_Buffer, 1);
+    }
+    if (size >= 64)
+    {
+        Transform(m_State, data, size / 64);
+        data += size & ~63UL;
+        size %= 64;
     }
+    memcpy(m_Buffer, data, size);
+}
 
-    /* Append total_bits, split this uint64 into two uint32 */
-    block[16 - 1] = (unsigned int)total_bits;
-    block[16 - 2] = (unsigned int)(total_bits >> 32);
-    Transform(block, digest, transforms);
-    reply.Capacity(20);
-    reply.SetPosition(0);
+void CGXDLMSSha1::Update(CGXByteBuffer& data)
+{
+    Update(data.GetData() + data.GetPosition(), data.Available());
+}
+
+int CGXDLMSSha1::Final(CGXByteBuffer& reply)
+{
+    unsigned char pos, used = (unsigned char)(m_Length % 64);
+    /* Total number of hashed bits */
+    uint64_t total_bits = m_Length * 8;
+    /* Padding */
+    m_Buffer[used++] = 0x80;
+    if (used > 64 - 8)
+    {
+        memset(m_Buffer + used, 0, sizeof(m_Buffer) - used);
+        Transform(m_State, m_Buffer, 1);
+        used = 0;
+    }
+    memset(m_Buffer + used, 0, 64 - 8 - used);
+    for (pos = 0; pos != 8; ++pos)
+    {
+        m_Buffer[63 - pos] = (unsigned char)(total_bits >> (8 * pos));
+    }
+    Transform(m_State, m_Buffer, 1);
     reply.SetSize(0);
+    reply.Capacity(20);
     for (pos = 0; pos < 5; ++pos)
     {
-        reply.SetUInt32(digest[pos]);
+        reply.SetUInt32(m_State[pos]);
     }
+    Init();
     return 0;
 }
 
 int CGXDLMSSha1::Encrypt(
-    CGXByteBuffer& data, 
+    CGXByteBuffer& data,
     CGXByteBuffer& result)
 {
-    unsigned int digest[5] = { 
-        0x67452301, 0xefcdab89, 0x98badcfe, 
-        0x10325476, 0xc3d2e1f0 };
-    unsigned int transforms = 0;
-    Update(data, digest, &transforms);
-    return Final(data, digest, &transforms, result);
-}
\ No newline at end of file
+    CGXDLMSSha1 sha;
+    sha.Update(data);
+    return sha.Final(result);
+}
@@ -34,6 +34,12 @@
 
 #include <string.h>
 #include "../include/GXDLMSSha256.h"
+#include "../include/GXDLMSShaNi.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GX_SHA256_LANES
+#endif
 
 const uint32_t sha256_k[64] =
 { 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
@@ -82,87 +88,310 @@ const uint32_t sha256_k[64] =
     *((str) + 0) = (unsigned char) ((x) >> 56);       \
 }
 
+static const uint32_t SHA256_INIT[8] = {
+    0x6a09e667, 0xbb67ae85,
+    0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c,
+    0x1f83d9ab, 0x5be0cd19
+};
+
 void CGXDLMSSha256::Transform(uint32_t* h,
     const unsigned char* message,
-    uint32_t messageLength)
+    unsigned long blocks)
 {
+    if (CGXDLMSShaNi::IsSupported())
+    {
+        CGXDLMSShaNi::Sha256(h, message, blocks);
+        return;
+    }
     uint32_t w[64];
     uint32_t wv[8];
     uint32_t t1, t2;
     unsigned char pos;
+    for (; blocks != 0; --blocks, message += 64)
+    {
+        for (pos = 0; pos < 16; ++pos)
+        {
+            SHA2_PACK32(&message[pos << 2], &w[pos]);
+        }
+        for (pos = 16; pos < 64; pos++)
+        {
+            w[pos] = SHA256_F4(w[pos - 2]) + w[pos - 7] + SHA256_F3(w[pos - 15]) + w[pos - 16];
+        }
+        for (pos = 0; pos < 8; pos++)
+        {
+            wv[pos] = h[pos];
+        }
+        for (pos = 0; pos < 64; pos++) {
+            t1 = wv[7] + SHA256_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
+                + sha256_k[pos] + w[pos];
+            t2 = SHA256_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
+            wv[7] = wv[6];
+            wv[6] = wv[5];
+            wv[5] = wv[4];
+            wv[4] = wv[3] + t1;
+            wv[3] = wv[2];
+            wv[2] = wv[1];
+            wv[1] = wv[0];
+            wv[0] = t1 + t2;
+        }
+        for (pos = 0; pos < 8; pos++)
+        {
+            h[pos] += wv[pos];
+        }
+    }
+}
+
+CGXDLMSSha256::CGXDLMSSha256()
+{
+    Init();
+}
+
+void CGXDLMSSha256::Init()
+{
+    memcpy(m_State, SHA256_INIT, sizeof(m_State));
+    m_Length = 0;
+}
+
+void CGXDLMSSha256::Update(const unsigned char* data,
+    unsigned long size)
+{
+    unsigned long used = (unsigned long)(m_Length % 64);
+    m_Length += size;
+    if (used != 0)
+    {
+        unsigned long count = 64 - used;
+        if (count > size)
+        {
+            count = size;
+        }
+        memcpy(m_Buffer + used, data, count);
+        data += count;
+        size -= count;
+        if (used + count != 64)
+        {
+            return;
+        }
+        Transform(m_State, m_Buffer, 1);
+    }
+    if (size >= 64)
+    {
+        Transform(m_State, data, size / 64);
+        data += size & ~63UL;
+        size %= 64;
+    }
+    memcpy(m_Buffer, data, size);
+}
+
+void CGXDLMSSha256::Update(CGXByteBuffer& data)
+{
+    Update(data.GetData() + data.GetPosition(), data.Available());
+}
+
+int CGXDLMSSha256::Final(CGXByteBuffer& digest)
+{
+    unsigned char pos, used = (unsigned char)(m_Length % 64);
+    uint64_t bits = m_Length << 3;
+    // Append a bit 1
+    m_Buffer[used++] = 0x80;
+    if (used > 56)
+    {
+        memset(m_Buffer + used, 0, sizeof(m_Buffer) - used);
+        Transform(m_State, m_Buffer, 1);
+        used = 0;
+    }
+    memset(m_Buffer + used, 0, 56 - used);
+    //Add bit length to the end of last block.
+    SHA2_UNPACK64(bits, m_Buffer + 56);
+    Transform(m_State, m_Buffer, 1);
+    digest.SetSize(0);
+    digest.Capacity(32);
+    for (pos = 0; pos < 8; ++pos)
+    {
+        digest.SetUInt32(m_State[pos]);
+    }
+    Init();
+    return 0;
+}
+
+int CGXDLMSSha256::Hash(
+    CGXByteBuffer& data,
+    CGXByteBuffer& digest)
+{
+    CGXDLMSSha256 sha;
+    sha.Update(data);
+    return sha.Final(digest);
+}
+
+#ifdef GX_SHA256_LANES
+
+#define SHA256_LANE_ROTR(x, n) _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n))
+#define SHA256_LANE_XOR3(x, y, z) _mm_xor_si128(_mm_xor_si128(x, y), z)
+#define SHA256_LANE_F1(x) SHA256_LANE_XOR3(SHA256_LANE_ROTR(x, 2), SHA256_LANE_ROTR(x, 13), SHA256_LANE_ROTR(x, 22))
+#define SHA256_LANE_F2(x) SHA256_LANE_XOR3(SHA256_LANE_ROTR(x, 6), SHA256_LANE_ROTR(x, 11), SHA256_LANE_ROTR(x, 25))
+#define SHA256_LANE_F3(x) SHA256_LANE_XOR3(SHA256_LANE_ROTR(x, 7), SHA256_LANE_ROTR(x, 18), _mm_srli_epi32(x, 3))
+#define SHA256_LANE_F4(x) SHA256_LANE_XOR3(SHA256_LANE_ROTR(x, 17), SHA256_LANE_ROTR(x, 19), _mm_srli_epi32(x, 10))
+#define SHA256_LANE_CH(x, y, z) _mm_xor_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z))
+#define SHA256_LANE_MAJ(x, y, z) SHA256_LANE_XOR3(_mm_and_si128(x, y), _mm_and_si128(x, z), _mm_and_si128(y, z))
+
+static uint32_t GetUInt32(const unsigned char* data)
+{
+    uint32_t value;
+    SHA2_PACK32(data, &value);
+    return value;
+}
+
+/*Hash one block of four messages. Each 32-bit lane holds one message.*/
+static void TransformLanes(__m128i* h, const unsigned char** blocks)
+{
+    __m128i w[64];
+    __m128i wv[8];
+    __m128i t1, t2;
+    unsigned char pos;
     for (pos = 0; pos < 16; ++pos)
     {
-        SHA2_PACK32(&message[pos << 2], &w[pos]);
+        w[pos] = _mm_set_epi32(
+            (int)GetUInt32(blocks[3] + 4 * pos),
+            (int)GetUInt32(blocks[2] + 4 * pos),
+            (int)GetUInt32(blocks[1] + 4 * pos),
+            (int)GetUInt32(blocks[0] + 4 * pos));
     }
     for (pos = 16; pos < 64; pos++)
     {
-        w[pos] = SHA256_F4(w[pos - 2]) + w[pos - 7] + SHA256_F3(w[pos - 15]) + w[pos - 16];
+        w[pos] = _mm_add_epi32(_mm_add_epi32(SHA256_LANE_F4(w[pos - 2]), w[pos - 7]),
+            _mm_add_epi32(SHA256_LANE_F3(w[pos - 15]), w[pos - 16]));
     }
     for (pos = 0; pos < 8; pos++)
     {
         wv[pos] = h[pos];
     }
     for (pos = 0; pos < 64; pos++) {
-        t1 = wv[7] + SHA256_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
-            + sha256_k[pos] + w[pos];
-        t2 = SHA256_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
+        t1 = _mm_add_epi32(_mm_add_epi32(wv[7], SHA256_LANE_F2(wv[4])),
+            _mm_add_epi32(SHA256_LANE_CH(wv[4], wv[5], wv[6]),
+                _mm_add_epi32(_mm_set1_epi32((int)sha256_k[pos]), w[pos])));
+        t2 = _mm_add_epi32(SHA256_LANE_F1(wv[0]), SHA256_LANE_MAJ(wv[0], wv[1], wv[2]));
         wv[7] = wv[6];
         wv[6] = wv[5];
         wv[5] = wv[4];
-        wv[4] = wv[3] + t1;
+        wv[4] = _mm_add_epi32(wv[3], t1);
         wv[3] = wv[2];
         wv[2] = wv[1];
         wv[1] = wv[0];
-        wv[0] = t1 + t2;
+        wv[0] = _mm_add_epi32(t1, t2);
     }
     for (pos = 0; pos < 8; pos++)
     {
-        h[pos] += wv[pos];
+        h[pos] = _mm_add_epi32(h[pos], wv[pos]);
     }
 }
 
-int CGXDLMSSha256::Hash(
-    CGXByteBuffer& data,
-    CGXByteBuffer& digest)
+/*Hash four buffers in parallel.*/
+static void HashLanes(CGXByteBuffer** data, CGXByteBuffer* digests)
 {
-    uint32_t len = data.GetSize();
-    uint32_t h[8] = { 0x6a09e667, 0xbb67ae85,
-        0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c,
-        0x1f83d9ab, 0x5be0cd19
-    };
-    unsigned char block[64];
-    unsigned char pos, size = sizeof(block);
-    bool bidsAdded = false;
-    while (!bidsAdded)
-    {
-        if (data.Available() < 64)
+    static const unsigned char EMPTY[64] = { 0 };
+    //Last one or two blocks of each message with the padding.
+    unsigned char tails[4][128];
+    const unsigned char* messages[4];
+    const unsigned char* blocks[4];
+    unsigned long full[4], total[4], count = 0;
+    unsigned char lane, pos;
+    __m128i h[8], saved[8];
+    for (pos = 0; pos != 8; ++pos)
+    {
+        h[pos] = _mm_set1_epi32((int)SHA256_INIT[pos]);
+    }
+    for (lane = 0; lane != 4; ++lane)
+    {
+        unsigned long size = data[lane]->Available();
+        unsigned char rest = (unsigned char)(size % 64), tail = rest < 56 ? 64 : 128;
+        messages[lane] = data[lane]->GetData() + data[lane]->GetPosition();
+        full[lane] = size / 64;
+        memcpy(tails[lane], messages[lane] + 64 * full[lane], rest);
+        tails[lane][rest] = 0x80;
+        memset(tails[lane] + rest + 1, 0, tail - rest - 1);
+        uint64_t bits = (uint64_t)size << 3;
+        SHA2_UNPACK64(bits, tails[lane] + tail - 8);
+        total[lane] = full[lane] + tail / 64;
+        if (total[lane] > count)
+        {
+            count = total[lane];
+        }
+    }
+    for (unsigned long block = 0; block != count; ++block)
+    {
+        bool ready = false;
+        for (lane = 0; lane != 4; ++lane)
         {
-            size = (unsigned char) data.Available();
+            if (block < full[lane])
+            {
+                blocks[lane] = messages[lane] + 64 * block;
+            }
+            else if (block < total[lane])
+            {
+                blocks[lane] = tails[lane] + 64 * (block - full[lane]);
+            }
+            else
+            {
+                blocks[lane] = EMPTY;
+                ready = true;
+            }
         }
-        memcpy(block, data.GetData() + data.GetPosition(), size);
-        memset(block + size, 0, sizeof(block) - size);
-        if (data.Available() < 64 && size != 0)
+        memcpy(saved, h, sizeof(h));
+        TransformLanes(h, blocks);
+        if (ready)
+        {
+            //Keep the state of the messages that are already hashed.
+            __m128i mask = _mm_set_epi32(
+                block < total[3] ? -1 : 0,
+                block < total[2] ? -1 : 0,
+                block < total[1] ? -1 : 0,
+                block < total[0] ? -1 : 0);
+            for (pos = 0; pos != 8; ++pos)
+            {
+                h[pos] = _mm_or_si128(_mm_and_si128(mask, h[pos]), _mm_andnot_si128(mask, saved[pos]));
+            }
+        }
+    }
+    uint32_t words[8][4];
+    for (pos = 0; pos != 8; ++pos)
+    {
+        _mm_storeu_si128((__m128i*)words[pos], h[pos]);
+    }
+    for (lane = 0; lane != 4; ++lane)
+    {
+        digests[lane].SetSize(0);
+        digests[lane].Capacity(32);
+        for (pos = 0; pos != 8; ++pos)
         {
-            // Append a bit 1
-            block[size] = 0x80;
+            digests[lane].SetUInt32(words[pos][lane]);
         }
+    }
+}
+#endif //GX_SHA256_LANES
 
-        if (data.Available() < 56)
+int CGXDLMSSha256::Hash(
+    std::vector<CGXByteBuffer*>& data,
+    std::vector<CGXByteBuffer>& digests)
+{
+    int ret;
+    size_t pos = 0;
+    digests.resize(data.size());
+#ifdef GX_SHA256_LANES
+    //SHA extensions are faster than SSE2 lanes.
+    if (!CGXDLMSShaNi::IsSupported())
+    {
+        for (; pos + 4 <= data.size(); pos += 4)
         {
-            bidsAdded = true;
-            //Add bit length to the end of last block.
-            uint64_t len_b = (len) << 3;
-            SHA2_UNPACK64(len_b, block + sizeof(block) - 8);
+            HashLanes(&data[pos], &digests[pos]);
         }
-        Transform(h, block, size);
-        data.SetPosition(size + data.GetPosition());
     }
-    digest.SetSize(0);
-    digest.Capacity(32);
-    for (pos = 0; pos < 8; ++pos)
+#endif //GX_SHA256_LANES
+    for (; pos != data.size(); ++pos)
     {
-        digest.SetUInt32(h[pos]);
+        if ((ret = Hash(*data[pos], digests[pos])) != 0)
+        {
+            return ret;
+        }
     }
     return 0;
-}
\ No newline at end of file
+}
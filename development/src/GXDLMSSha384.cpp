@@ -91,91 +91,130 @@ const uint64_t sha384_k[] = {
 
 void CGXDLMSSha384::Transform(uint64_t* h,
     const unsigned char* message,
-    unsigned int messageLength)
+    unsigned long blocks)
 {
     uint64_t w[80];
     uint64_t wv[8];
     uint64_t t1, t2;
     unsigned char pos;
-    for (pos = 0; pos < 16; pos++)
+    for (; blocks != 0; --blocks, message += 128)
     {
-        SHA2_PACK64(&message[pos << 3], &w[pos]);
-    }
-    for (pos = 16; pos < 80; pos++)
-    {
-        w[pos] = SHA364_F3(w[pos - 15]) + w[pos - 7] + SHA364_F4(w[pos - 2]) + w[pos - 16];
-    }
-    for (pos = 0; pos < 8; pos++)
-    {
-        wv[pos] = h[pos];
-    }
-    for (pos = 0; pos < 80; pos++) {
-        t1 = wv[7] + SHA364_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
-            + sha384_k[pos] + w[pos];
-        t2 = SHA364_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
-        wv[7] = wv[6];
-        wv[6] = wv[5];
-        wv[5] = wv[4];
-        wv[4] = wv[3] + t1;
-        wv[3] = wv[2];
-        wv[2] = wv[1];
-        wv[1] = wv[0];
-        wv[0] = t1 + t2;			      
-    }
-    for (pos = 0; pos < 8; pos++)
-    {
-        h[pos] += wv[pos];
+        for (pos = 0; pos < 16; pos++)
+        {
+            SHA2_PACK64(&message[pos << 3], &w[pos]);
+        }
+        for (pos = 16; pos < 80; pos++)
+        {
+            w[pos] = SHA364_F3(w[pos - 15]) + w[pos - 7] + SHA364_F4(w[pos - 2]) + w[pos - 16];
+        }
+        for (pos = 0; pos < 8; pos++)
+        {
+            wv[pos] = h[pos];
+        }
+        for (pos = 0; pos < 80; pos++) {
+            t1 = wv[7] + SHA364_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
+                + sha384_k[pos] + w[pos];
+            t2 = SHA364_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
+            wv[7] = wv[6];
+            wv[6] = wv[5];
+            wv[5] = wv[4];
+            wv[4] = wv[3] + t1;
+            wv[3] = wv[2];
+            wv[2] = wv[1];
+            wv[1] = wv[0];
+            wv[0] = t1 + t2;
+        }
+        for (pos = 0; pos < 8; pos++)
+        {
+            h[pos] += wv[pos];
+        }
     }
 }
 
-int CGXDLMSSha384::Hash(
-    CGXByteBuffer& data,
-    CGXByteBuffer& digest)
+CGXDLMSSha384::CGXDLMSSha384()
+{
+    Init();
+}
+
+void CGXDLMSSha384::Init()
 {
-    uint32_t len = data.GetSize();
-    uint64_t h[8] = {
-        0xcbbb9d5dc1059ed8,
-        0x629a292a367cd507,
-        0x9159015a3070dd17,
-        0x152fecd8f70e5939,
-        0x67332667ffc00b31,
-        0x8eb44a8768581511,
-        0xdb0c2e0d64f98fa7,
-        0x47b5481dbefa4fa4 };
-    unsigned char block[128];
-    unsigned char pos, size = sizeof(block);
-    bool bidsAdded = false;
-    bool eofAdded = false;
-    while (!bidsAdded)
+    m_State[0] = 0xcbbb9d5dc1059ed8;
+    m_State[1] = 0x629a292a367cd507;
+    m_State[2] = 0x9159015a3070dd17;
+    m_State[3] = 0x152fecd8f70e5939;
+    m_State[4] = 0x67332667ffc00b31;
+    m_State[5] = 0x8eb44a8768581511;
+    m_State[6] = 0xdb0c2e0d64f98fa7;
+    m_State[7] = 0x47b5481dbefa4fa4;
+    m_Length = 0;
+}
+
+void CGXDLMSSha384::Update(const unsigned char* data,
+    unsigned long size)
+{
+    unsigned long used = (unsigned long)(m_Length % 128);
+    m_Length += size;
+    if (used != 0)
     {
-        if (data.Available() < 128)
-        {
-            size = (unsigned char) data.Available();
-        }
-        memcpy(block, data.GetData() + data.GetPosition(), size);
-        memset(block + size, 0, sizeof(block) - size);
-        if (data.Available() < 128 && !eofAdded)
+        unsigned long count = 128 - used;
+        if (count > size)
         {
-            // Append a bit 1.
-            block[size] = 0x80;
-            eofAdded = true;
+            count = size;
         }
-        if (data.Available() < 112)
+        memcpy(m_Buffer + used, data, count);
+        data += count;
+        size -= count;
+        if (used + count != 128)
         {
-            bidsAdded = true;
-            //Add bit length to the end of last block.
-            uint64_t len_b = (len) << 3;
-            SHA2_UNPACK64(len_b, block + sizeof(block) - 8);
+            return;
         }
-        Transform(h, block, size);
-        data.SetPosition(size + data.GetPosition());
+        Transform(m_State, m_Buffer, 1);
     }
-    digest.Capacity(48);
+    if (size >= 128)
+    {
+        Transform(m_State, data, size / 128);
+        data += size & ~127UL;
+        size %= 128;
+    }
+    memcpy(m_Buffer, data, size);
+}
+
+void CGXDLMSSha384::Update(CGXByteBuffer& data)
+{
+    Update(data.GetData() + data.GetPosition(), data.Available());
+}
+
+int CGXDLMSSha384::Final(CGXByteBuffer& digest)
+{
+    unsigned char pos, used = (unsigned char)(m_Length % 128);
+    uint64_t bits = m_Length << 3;
+    // Append a bit 1.
+    m_Buffer[used++] = 0x80;
+    if (used > 112)
+    {
+        memset(m_Buffer + used, 0, sizeof(m_Buffer) - used);
+        Transform(m_State, m_Buffer, 1);
+        used = 0;
+    }
+    //Length is 128 bits. High bits are always zero.
+    memset(m_Buffer + used, 0, 120 - used);
+    SHA2_UNPACK64(bits, m_Buffer + 120);
+    Transform(m_State, m_Buffer, 1);
     digest.SetSize(0);
+    digest.Capacity(48);
     for (pos = 0; pos < 6; ++pos)
     {
-        digest.SetUInt64(h[pos]);
-    } 
-    digest.SetSize(48);
+        digest.SetUInt64(m_State[pos]);
+    }
+    Init();
     return 0;
-}
\ No newline at end of file
+}
+
+int CGXDLMSSha384::Hash(
+    CGXByteBuffer& data,
+    CGXByteBuffer& digest)
+{
+    CGXDLMSSha384 sha;
+    sha.Update(data);
+    return sha.Final(digest);
+}
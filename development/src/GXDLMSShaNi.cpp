@@ -0,0 +1,250 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include "../include/GXDLMSShaNi.h"
+
+#if !defined(DLMS_IGNORE_SHA_NI) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define GX_SHA_NI
+#endif
+
+#ifdef GX_SHA_NI
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#define GX_SHA_TARGET
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define GX_SHA_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+
+/*Check SHA, SSSE3 and SSE4.1 support from CPUID.*/
+static bool GetShaSupport()
+{
+    unsigned int regs1[4], regs7[4];
+#if defined(_MSC_VER)
+    __cpuid((int*)regs1, 0);
+    if (regs1[0] < 7)
+    {
+        return false;
+    }
+    __cpuid((int*)regs1, 1);
+    __cpuidex((int*)regs7, 7, 0);
+#else
+    if (__get_cpuid_max(0, 0) < 7)
+    {
+        return false;
+    }
+    __cpuid(1, regs1[0], regs1[1], regs1[2], regs1[3]);
+    __cpuid_count(7, 0, regs7[0], regs7[1], regs7[2], regs7[3]);
+#endif
+    //SSSE3, SSE4.1 and SHA.
+    return (regs1[2] & (1 << 9)) != 0 &&
+        (regs1[2] & (1 << 19)) != 0 &&
+        (regs7[1] & (1 << 29)) != 0;
+}
+
+static const bool SHA_SUPPORTED = GetShaSupport();
+static bool SHA_ENABLED = true;
+
+static const uint32_t SHA256_K[64] =
+{ 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+//Four SHA-256 rounds. m0 holds the message words of these rounds.
+//Message words of the next rounds are counted to m1 and m3.
+#define SHA256_ROUNDS(pos, m0, m1, m3) \
+    value = _mm_add_epi32(m0, _mm_loadu_si128((const __m128i*) & SHA256_K[4 * pos])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, value); \
+    if (pos > 2 && pos < 15) \
+    { \
+        m1 = _mm_sha256msg2_epu32(_mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)), m0); \
+    } \
+    value = _mm_shuffle_epi32(value, 0x0E); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, value); \
+    if (pos > 0 && pos < 13) \
+    { \
+        m3 = _mm_sha256msg1_epu32(m3, m0); \
+    }
+
+GX_SHA_TARGET
+static void Sha256Blocks(uint32_t* state, const unsigned char* data, unsigned long blocks)
+{
+    __m128i msg0, msg1, msg2, msg3, tmp, abefSave, cdghSave, value;
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    //State is kept as ABEF and CDGH.
+    tmp = _mm_loadu_si128((const __m128i*) & state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i*) & state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+    for (; blocks != 0; --blocks, data += 64)
+    {
+        abefSave = state0;
+        cdghSave = state1;
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data)), MASK);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), MASK);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), MASK);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), MASK);
+        SHA256_ROUNDS(0, msg0, msg1, msg3);
+        SHA256_ROUNDS(1, msg1, msg2, msg0);
+        SHA256_ROUNDS(2, msg2, msg3, msg1);
+        SHA256_ROUNDS(3, msg3, msg0, msg2);
+        SHA256_ROUNDS(4, msg0, msg1, msg3);
+        SHA256_ROUNDS(5, msg1, msg2, msg0);
+        SHA256_ROUNDS(6, msg2, msg3, msg1);
+        SHA256_ROUNDS(7, msg3, msg0, msg2);
+        SHA256_ROUNDS(8, msg0, msg1, msg3);
+        SHA256_ROUNDS(9, msg1, msg2, msg0);
+        SHA256_ROUNDS(10, msg2, msg3, msg1);
+        SHA256_ROUNDS(11, msg3, msg0, msg2);
+        SHA256_ROUNDS(12, msg0, msg1, msg3);
+        SHA256_ROUNDS(13, msg1, msg2, msg0);
+        SHA256_ROUNDS(14, msg2, msg3, msg1);
+        SHA256_ROUNDS(15, msg3, msg0, msg2);
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i*) & state[0], state0);
+    _mm_storeu_si128((__m128i*) & state[4], state1);
+}
+
+//Four SHA-1 rounds. Message words of the rounds are counted to m0 from the earlier words.
+#define SHA1_ROUNDS(pos, m0, m1, m2, m3) \
+    if (pos > 3) \
+    { \
+        m0 = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(m0, m1), m2), m3); \
+    } \
+    e = _mm_sha1nexte_epu32(previous, m0); \
+    previous = abcd; \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, pos / 5);
+
+GX_SHA_TARGET
+static void Sha1Blocks(uint32_t* state, const unsigned char* data, unsigned long blocks)
+{
+    __m128i msg0, msg1, msg2, msg3, abcdSave, e0Save, e, previous;
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) state), 0x1B);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+    for (; blocks != 0; --blocks, data += 64)
+    {
+        abcdSave = abcd;
+        e0Save = e0;
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data)), MASK);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), MASK);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), MASK);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), MASK);
+        e = _mm_add_epi32(e0, msg0);
+        previous = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+        SHA1_ROUNDS(1, msg1, msg2, msg3, msg0);
+        SHA1_ROUNDS(2, msg2, msg3, msg0, msg1);
+        SHA1_ROUNDS(3, msg3, msg0, msg1, msg2);
+        SHA1_ROUNDS(4, msg0, msg1, msg2, msg3);
+        SHA1_ROUNDS(5, msg1, msg2, msg3, msg0);
+        SHA1_ROUNDS(6, msg2, msg3, msg0, msg1);
+        SHA1_ROUNDS(7, msg3, msg0, msg1, msg2);
+        SHA1_ROUNDS(8, msg0, msg1, msg2, msg3);
+        SHA1_ROUNDS(9, msg1, msg2, msg3, msg0);
+        SHA1_ROUNDS(10, msg2, msg3, msg0, msg1);
+        SHA1_ROUNDS(11, msg3, msg0, msg1, msg2);
+        SHA1_ROUNDS(12, msg0, msg1, msg2, msg3);
+        SHA1_ROUNDS(13, msg1, msg2, msg3, msg0);
+        SHA1_ROUNDS(14, msg2, msg3, msg0, msg1);
+        SHA1_ROUNDS(15, msg3, msg0, msg1, msg2);
+        SHA1_ROUNDS(16, msg0, msg1, msg2, msg3);
+        SHA1_ROUNDS(17, msg1, msg2, msg3, msg0);
+        SHA1_ROUNDS(18, msg2, msg3, msg0, msg1);
+        SHA1_ROUNDS(19, msg3, msg0, msg1, msg2);
+        e0 = _mm_sha1nexte_epu32(previous, e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+    _mm_storeu_si128((__m128i*) state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+#endif //GX_SHA_NI
+
+bool CGXDLMSShaNi::IsSupported()
+{
+#ifdef GX_SHA_NI
+    return SHA_SUPPORTED && SHA_ENABLED;
+#else
+    return false;
+#endif //GX_SHA_NI
+}
+
+void CGXDLMSShaNi::SetEnabled(bool value)
+{
+#ifdef GX_SHA_NI
+    SHA_ENABLED = value;
+#endif //GX_SHA_NI
+}
+
+void CGXDLMSShaNi::Sha256(uint32_t* state,
+    const unsigned char* data,
+    unsigned long blocks)
+{
+#ifdef GX_SHA_NI
+    Sha256Blocks(state, data, blocks);
+#endif //GX_SHA_NI
+}
+
+void CGXDLMSShaNi::Sha1(uint32_t* state,
+    const unsigned char* data,
+    unsigned long blocks)
+{
+#ifdef GX_SHA_NI
+    Sha1Blocks(state, data, blocks);
+#endif //GX_SHA_NI
+}
@@ -109,11 +109,15 @@ void CGXDLMSValueEventArg::Init(
     SetIndex(index);
     m_Selector = selector;
     m_Error = DLMS_ERROR_CODE_OK;
+    m_Action = false;
     m_ByteArray = false;
     m_SkipMaxPduSize = false;
     m_RowToPdu = 0;
     m_RowBeginIndex = 0;
     m_RowEndIndex = 0;
+    m_InvokeId = 0;
+    m_Producer = NULL;
+    m_ProducerPosition = 0;
 }
 
 CGXDLMSValueEventArg::CGXDLMSValueEventArg(
@@ -236,4 +240,24 @@ void CGXDLMSValueEventArg::SetInvokeId(unsigned int value)
 unsigned int CGXDLMSValueEventArg::GetInvokeId()
 {
     return m_InvokeId;
-}
\ No newline at end of file
+}
+
+IGXDLMSValueProducer* CGXDLMSValueEventArg::GetProducer()
+{
+    return m_Producer;
+}
+
+void CGXDLMSValueEventArg::SetProducer(IGXDLMSValueProducer* value)
+{
+    m_Producer = value;
+}
+
+unsigned long CGXDLMSValueEventArg::GetProducerPosition()
+{
+    return m_ProducerPosition;
+}
+
+void CGXDLMSValueEventArg::SetProducerPosition(unsigned long value)
+{
+    m_ProducerPosition = value;
+}
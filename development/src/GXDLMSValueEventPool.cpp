@@ -0,0 +1,126 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include "../include/GXDLMSValueEventPool.h"
+
+CGXDLMSValueEventPool::CGXDLMSValueEventPool() : m_Allocated(0)
+{
+}
+
+CGXDLMSValueEventPool::~CGXDLMSValueEventPool()
+{
+    Clear();
+}
+
+CGXDLMSValueEventArg* CGXDLMSValueEventPool::Acquire(
+    CGXDLMSServer* server,
+    CGXDLMSObject* target,
+    int index,
+    int selector,
+    CGXDLMSVariant* parameters)
+{
+    CGXDLMSValueEventArg* e;
+    if (m_Args.empty())
+    {
+        ++m_Allocated;
+        if (parameters == NULL)
+        {
+            e = new CGXDLMSValueEventArg(server, target, index);
+            e->m_Selector = selector;
+        }
+        else
+        {
+            e = new CGXDLMSValueEventArg(server, target, index, selector, *parameters);
+        }
+    }
+    else
+    {
+        e = m_Args.back();
+        m_Args.pop_back();
+        e->Init(server, target, index, selector);
+        if (parameters != NULL)
+        {
+            e->m_Parameters = *parameters;
+        }
+    }
+    return e;
+}
+
+void CGXDLMSValueEventPool::Release(CGXDLMSValueEventArg* value)
+{
+    //Values are released so the pool don't keep large replies alive.
+    value->m_Value.Clear();
+    value->m_Parameters.Clear();
+    m_Args.push_back(value);
+}
+
+void CGXDLMSValueEventPool::TakeList(std::vector<CGXDLMSValueEventArg*>& list)
+{
+    if (!m_Lists.empty())
+    {
+        list.swap(m_Lists.back());
+        m_Lists.pop_back();
+    }
+}
+
+void CGXDLMSValueEventPool::ReturnList(std::vector<CGXDLMSValueEventArg*>& list)
+{
+    list.clear();
+    if (list.capacity() != 0)
+    {
+        m_Lists.push_back(std::vector<CGXDLMSValueEventArg*>());
+        m_Lists.back().swap(list);
+    }
+}
+
+unsigned long CGXDLMSValueEventPool::GetAllocated()
+{
+    return m_Allocated;
+}
+
+unsigned long CGXDLMSValueEventPool::GetSize()
+{
+    return (unsigned long)m_Args.size();
+}
+
+void CGXDLMSValueEventPool::Clear()
+{
+    for (std::vector<CGXDLMSValueEventArg*>::iterator it = m_Args.begin(); it != m_Args.end(); ++it)
+    {
+        delete *it;
+    }
+    m_Args.clear();
+    m_Lists.clear();
+}
@@ -64,7 +64,7 @@ static void GetUtcOffset(struct tm* timeptr, int& hours, int& minutes, int& devi
 #if _MSC_VER > 1000
     localtime_s(&tm, &zero);
 #else
-    tm = *localtime(&zero);
+    localtime_r(&zero, &tm);
 #endif
     GetTimeZoneInformation(&tz);
     if (tz.DaylightBias % 60 == 0)
@@ -78,7 +78,7 @@ static void GetUtcOffset(struct tm* timeptr, int& hours, int& minutes, int& devi
     }
 #endif
 #if defined(__linux__)
-    tm = *localtime(&zero);
+    localtime_r(&zero, &tm);
     short gmtoff = (short)(tm.tm_gmtoff / 60);
     addH = (short)(gmtoff / 60);
     addMin = (short)(gmtoff % 60);
@@ -134,7 +134,7 @@ CGXDateTime::CGXDateTime()
 #if _MSC_VER > 1000
     localtime_s(&dt, &tm1);
 #else
-    dt = *localtime(&tm1);
+    localtime_r(&tm1, &dt);
 #endif
     GetUtcOffset(&dt, hours, minutes, deviation);
     m_Deviation = -(hours * 60 + minutes);
@@ -174,7 +174,7 @@ CGXDateTime::CGXDateTime(const unsigned long unixTime)
 #if _MSC_VER > 1000
     gmtime_s(&m_Value, &t);
 #else
-    m_Value = *gmtime(&t);
+    gmtime_r(&t, &m_Value);
 #endif
     m_Skip = DATETIME_SKIPS_NONE;
     m_Extra = DATE_TIME_EXTRA_INFO_NONE;
@@ -189,7 +189,7 @@ CGXDateTime::CGXDateTime(const unsigned long long unixTime)
 #if _MSC_VER > 1000
     gmtime_s(&m_Value, &t);
 #else
-    m_Value = *gmtime(&t);
+    gmtime_r(&t, &m_Value);
 #endif
     m_Skip = DATETIME_SKIPS_NONE;
     m_Extra = DATE_TIME_EXTRA_INFO_NONE;
@@ -233,7 +233,7 @@ CGXDateTime::CGXDateTime(int year, int month, int day, int hour, int minute, int
 #if _MSC_VER > 1000
         localtime_s(&dt, &tm1);
 #else
-        dt = *localtime(&tm1);
+        localtime_r(&tm1, &dt);
 #endif
         GetUtcOffset(&dt, hours, minutes, deviation);
         Init(year, month, day, hour, minute, second, millisecond, -(hours * 60 + minutes));
@@ -1125,7 +1125,8 @@ CGXDateTime CGXDateTime::Now()
     struct tm dt;
     localtime_s(&dt, &tm1);
 #else
-    struct tm dt = *localtime(&tm1);
+    struct tm dt;
+    localtime_r(&tm1, &dt);
 #endif
     CGXDateTime now(dt);
     return now;
@@ -1327,7 +1328,7 @@ int CGXDateTime::ToLocalTime(struct tm& localTime) const
 #if _MSC_VER > 1000
         localtime_s(&localTime, &t);
 #else
-        localTime = *localtime(&t);
+        localtime_r(&t, &localTime);
 #endif
     }
     return 0;
@@ -36,6 +36,7 @@
 #include "../include/GXDLMSSha256.h"
 #include "../include/GXDLMSSha384.h"
 #include "../include/GXShamirs.h"
+#include "../include/GXFixedCurve.h"
 
 int CGXEcdsa::GetRandomNumber(CGXBigInteger& N,
     CGXByteBuffer& value)
@@ -78,6 +79,50 @@ CGXEcdsa::CGXEcdsa(CGXPrivateKey& key) :
     m_PrivateKey = key;
 }
 
+/**
+* Sign hash with fixed size integers.
+*/
+template <uint16_t BITS>
+static int FixedSign(CGXCurve& curve,
+    CGXByteBuffer& hash,
+    CGXByteArray& privateKey,
+    CGXByteBuffer& random,
+    CGXByteBuffer& signature)
+{
+    int ret;
+    CGXFixedCurve<BITS> c;
+    CGXFixedInteger<BITS> e, d, k, r, s, x, y;
+    CGXJacobianPoint<BITS> R;
+    unsigned char tmp[CGXFixedInteger<BITS>::SIZE];
+    if ((ret = c.Init(curve)) != 0 ||
+        (ret = e.FromBytes(hash.GetData(), hash.GetSize())) != 0 ||
+        (ret = d.FromBytes(privateKey.GetData(), privateKey.GetSize())) != 0 ||
+        (ret = k.FromBytes(random.GetData(), random.GetSize())) != 0)
+    {
+        return ret;
+    }
+    c.m_Order.Reduce(e, e);
+    c.m_Order.Reduce(k, k);
+    c.Multiply(R, c.m_G, k);
+    if ((ret = c.ToAffine(x, y, R)) != 0)
+    {
+        return ret;
+    }
+    c.m_Order.Reduce(r, x);
+    //s = (k ^ -1 * (e + d * r)) mod n
+    c.m_Order.Multiply(s, d, r);
+    c.m_Order.Add(s, s, e);
+    c.m_Order.Inverse(k, k);
+    c.m_Order.Multiply(s, s, k);
+    r.ToBytes(tmp);
+    if ((ret = signature.Set(tmp, sizeof(tmp))) == 0)
+    {
+        s.ToBytes(tmp);
+        ret = signature.Set(tmp, sizeof(tmp));
+    }
+    return ret;
+}
+
 int CGXEcdsa::Sign(CGXByteBuffer& data,
     CGXByteBuffer& signature)
 {
@@ -89,47 +134,30 @@ int CGXEcdsa::Sign(CGXByteBuffer& data,
         printf("Invalid private key.");
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
+    CGXByteBuffer hash;
     if (m_PrivateKey.GetScheme() == ECC_P256)
     {
-        if ((ret = CGXDLMSSha256::Hash(data, signature)) != 0)
-        {
-            return ret;
-        }
+        ret = CGXDLMSSha256::Hash(data, hash);
     }
     else
     {
-        if ((ret = CGXDLMSSha384::Hash(data, signature)) != 0)
-        {
-            return ret;
-        }
+        ret = CGXDLMSSha384::Hash(data, hash);
     }
     data.SetPosition(pos);
-    CGXBigInteger msg(signature);
-    signature.Clear();
-    CGXByteBuffer tmp;
-    if ((ret = GetRandomNumber(m_Curve.m_N, tmp)) == 0)
+    if (ret != 0)
     {
-        CGXBigInteger k(tmp);
-        CGXBigInteger pk(m_PrivateKey.m_RawValue.m_Data,
-            (uint16_t)m_PrivateKey.m_RawValue.m_Size);
-        CGXEccPoint R;
-        CGXShamirs::PointMulti(m_Curve, R, m_Curve.m_G, k);
-        CGXBigInteger r(R.X);
-        r.Mod(m_Curve.m_N);
-        //s = (k ^ -1 * (e + d * r)) mod n
-        CGXBigInteger s(pk);
-        s.Multiply(r);
-        s.Add(msg);
-        CGXBigInteger kinv(k);
-        kinv.Inv(m_Curve.m_N);
-        s.Multiply(kinv);
-        s.Mod(m_Curve.m_N);
-        tmp.Clear();
-        if (ret == 0 &&
-            (ret = r.ToArray(signature, false)) == 0 &&
-            (ret = s.ToArray(tmp, false)) == 0)
+        return ret;
+    }
+    CGXByteBuffer random;
+    if ((ret = GetRandomNumber(m_Curve.m_N, random)) == 0)
+    {
+        if (m_PrivateKey.GetScheme() == ECC_P256)
+        {
+            ret = FixedSign<256>(m_Curve, hash, m_PrivateKey.m_RawValue, random, signature);
+        }
+        else
         {
-            ret = signature.Set(tmp.GetData(), tmp.GetSize());
+            ret = FixedSign<384>(m_Curve, hash, m_PrivateKey.m_RawValue, random, signature);
         }
     }
     return ret;
@@ -199,52 +227,142 @@ int CGXEcdsa::Verify(CGXByteBuffer& signature,
     CGXByteBuffer& data,
     bool& value)
 {
-    value = false;
+    return Verify(NULL, signature, data, value);
+}
+
+int CGXEcdsa::Verify(CGXEccPoint& publicKey,
+    CGXByteBuffer& signature,
+    CGXByteBuffer& data,
+    bool& value)
+{
+    return Verify(&publicKey, signature, data, value);
+}
+
+/**
+* Verify signature with fixed size integers.
+*/
+template <uint16_t BITS>
+static int FixedVerify(CGXCurve& curve,
+    CGXEccPoint* publicKey,
+    CGXByteArray& rawKey,
+    CGXByteBuffer& hash,
+    CGXByteBuffer& signature,
+    bool& value)
+{
     int ret;
+    const uint16_t size = CGXFixedInteger<BITS>::SIZE;
+    CGXFixedCurve<BITS> c;
+    CGXFixedInteger<BITS> e, r, s, w, u1, u2, x, y;
+    CGXJacobianPoint<BITS> q;
+    if (signature.GetSize() != 2 * size)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if ((ret = c.Init(curve)) != 0 ||
+        (ret = e.FromBytes(hash.GetData(), hash.GetSize())) != 0 ||
+        (ret = r.FromBytes(signature.GetData(), size)) != 0 ||
+        (ret = s.FromBytes(signature.GetData() + size, size)) != 0)
+    {
+        return ret;
+    }
+    if (publicKey != NULL)
+    {
+        if ((ret = x.FromBigInteger(publicKey->X)) != 0 ||
+            (ret = y.FromBigInteger(publicKey->Y)) != 0)
+        {
+            return ret;
+        }
+    }
+    else if (rawKey.GetSize() != 1 + 2 * size ||
+        (ret = x.FromBytes(rawKey.GetData() + 1, size)) != 0 ||
+        (ret = y.FromBytes(rawKey.GetData() + 1 + size, size)) != 0)
+    {
+        return ret != 0 ? ret : DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    //Signature values must be between 1 and n - 1.
+    if (r.IsZero() || s.IsZero() ||
+        r.Compare(c.m_Order.m_Modulus) >= 0 ||
+        s.Compare(c.m_Order.m_Modulus) >= 0)
+    {
+        return 0;
+    }
+    c.m_Order.Reduce(e, e);
+    c.m_Order.Inverse(w, s);
+    c.m_Order.Multiply(u1, e, w);
+    c.m_Order.Multiply(u2, r, w);
+    c.FromAffine(q, x, y);
+    c.Trick(q, u1, u2, q);
+    if (c.ToAffine(x, y, q) == 0)
+    {
+        c.m_Order.Reduce(x, x);
+        value = x.Compare(r) == 0;
+    }
+    return 0;
+}
+
+int CGXEcdsa::Verify(CGXEccPoint* publicKey,
+    CGXByteBuffer& signature,
+    CGXByteBuffer& data,
+    bool& value)
+{
+    value = false;
+    int ret = 0;
     CGXByteBuffer bb;
     if (m_PublicKey.GetRawValue().GetSize() == 0)
     {
         if (m_PrivateKey.GetRawValue().GetSize() == 0)
         {
             printf("Invalid private key.");
-            ret = DLMS_ERROR_CODE_INVALID_PARAMETER;
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
         }
-        else 
+        if ((ret = m_PrivateKey.GetPublicKey(m_PublicKey)) != 0)
         {
-            ret = m_PrivateKey.GetPublicKey(m_PublicKey);
+            return ret;
         }
     }
     if (m_PublicKey.GetScheme() == ECC_P256)
     {
-        ret = CGXDLMSSha256::Hash(data, bb);
+        if ((ret = CGXDLMSSha256::Hash(data, bb)) == 0)
+        {
+            ret = FixedVerify<256>(m_Curve, publicKey, m_PublicKey.m_RawValue, bb, signature, value);
+        }
     }
     else if (m_PublicKey.GetScheme() == ECC_P384)
     {
-        ret = CGXDLMSSha384::Hash(data, bb);
+        if ((ret = CGXDLMSSha384::Hash(data, bb)) == 0)
+        {
+            ret = FixedVerify<384>(m_Curve, publicKey, m_PublicKey.m_RawValue, bb, signature, value);
+        }
     }
     else
     {
         ret = DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
-    if (ret == 0)
+    return ret;
+}
+
+/**
+* Check that public key is on the curve with fixed size integers.
+*/
+template <uint16_t BITS>
+static int FixedValidate(CGXCurve& curve,
+    CGXByteArray& rawKey,
+    bool& value)
+{
+    int ret;
+    const uint16_t size = CGXFixedInteger<BITS>::SIZE;
+    CGXFixedCurve<BITS> c;
+    CGXFixedInteger<BITS> x, y;
+    value = false;
+    if (rawKey.GetSize() != 1 + 2 * size)
+    {
+        return 0;
+    }
+    if ((ret = c.Init(curve)) == 0 &&
+        (ret = x.FromBytes(rawKey.GetData() + 1, size)) == 0 &&
+        (ret = y.FromBytes(rawKey.GetData() + 1 + size, size)) == 0)
     {
-        CGXBigInteger u1(bb);
-        int size = GetSchemeSize(m_PublicKey.m_Scheme);
-        signature.SubArray(0, size, bb);
-        CGXBigInteger sigR(bb);
-        signature.SubArray(size, size, bb);
-        CGXBigInteger sigS(bb);
-        CGXBigInteger w = sigS;
-        w.Inv(m_Curve.m_N);
-        u1.Multiply(w);
-        u1.Mod(m_Curve.m_N);
-        CGXBigInteger u2(sigR);
-        u2.Multiply(w);
-        u2.Mod(m_Curve.m_N);
-        CGXEccPoint tmp;
-        CGXShamirs::Trick(m_Curve, m_PublicKey, tmp, u1, u2);
-        tmp.X.Mod(m_Curve.m_N);
-        value = tmp.X.Compare(sigR) == 0;
+        value = c.IsOnCurve(x, y);
     }
     return ret;
 }
@@ -259,25 +377,20 @@ int CGXEcdsa::Validate(CGXPublicKey& publicKey)
     }
     else
     {
-        CGXByteBuffer bb;
-        int size = GetSchemeSize(publicKey.GetScheme());
-        publicKey.GetRawValue().SubArray(1, size, bb);
-        CGXBigInteger x(bb);
-        bb.SetSize(0);
-        publicKey.GetRawValue().SubArray(1 + size, size, bb);
-        CGXBigInteger y(bb);
+        bool valid;
         CGXCurve curve;
-        ret = curve.Init(publicKey.GetScheme());
-        y.Multiply(y);
-        y.Mod(curve.m_P);
-        CGXBigInteger tmpX(x);
-        tmpX.Multiply(x);
-        tmpX.Mod(curve.m_P);
-        tmpX.Add(curve.m_A);
-        tmpX.Multiply(x);
-        tmpX.Add(curve.m_B);
-        tmpX.Mod(curve.m_P);
-        if (y.Compare(tmpX) != 0)
+        if ((ret = curve.Init(publicKey.GetScheme())) == 0)
+        {
+            if (publicKey.GetScheme() == ECC_P256)
+            {
+                ret = FixedValidate<256>(curve, publicKey.m_RawValue, valid);
+            }
+            else
+            {
+                ret = FixedValidate<384>(curve, publicKey.m_RawValue, valid);
+            }
+        }
+        if (ret == 0 && !valid)
         {
             printf("Public key validate failed. Public key is not valid ECDSA key.");
             ret = DLMS_ERROR_CODE_INVALID_PARAMETER;
@@ -0,0 +1,156 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include "../include/GXSNIndex.h"
+#include "../include/GXDLMS.h"
+
+CGXSNIndex::CGXSNIndex()
+{
+    m_Count = 0;
+}
+
+/**
+ * Compare short name to the start of the range.
+ */
+struct CGXSNRangeCompare
+{
+    template <class T>
+    bool operator()(int sn, const T& range) const
+    {
+        return sn < range.m_Start;
+    }
+};
+
+/**
+ * Compare end of the range to the short name.
+ */
+struct CGXSNRangeEndCompare
+{
+    template <class T>
+    bool operator()(const T& range, int sn) const
+    {
+        return range.m_End <= sn;
+    }
+};
+
+void CGXSNIndex::Add(
+    std::vector<CGXSNRange>& ranges,
+    int start,
+    int end,
+    int base,
+    bool action,
+    CGXDLMSObject* target)
+{
+    //Ranges are sorted by the start and they don't overlap.
+    std::vector<CGXSNRange>::iterator it =
+        std::lower_bound(ranges.begin(), ranges.end(), start, CGXSNRangeEndCompare());
+    while (start < end)
+    {
+        while (it != ranges.end() && it->m_End <= start)
+        {
+            ++it;
+        }
+        int next = end;
+        if (it != ranges.end())
+        {
+            if (it->m_Start <= start)
+            {
+                //Beginning is used by an earlier object.
+                start = it->m_End;
+                continue;
+            }
+            if (it->m_Start < end)
+            {
+                next = it->m_Start;
+            }
+        }
+        CGXSNRange range;
+        range.m_Start = start;
+        range.m_End = next;
+        range.m_Base = base;
+        range.m_Action = action;
+        range.m_Object = target;
+        it = ranges.insert(it, range) + 1;
+        start = next;
+    }
+}
+
+void CGXSNIndex::Update(CGXDLMSObjectCollection& objects)
+{
+    unsigned char offset, count;
+    std::vector<CGXSNRange> ranges;
+    ranges.reserve(2 * objects.size());
+    for (CGXDLMSObjectCollection::iterator it = objects.begin(); it != objects.end(); ++it)
+    {
+        int sn = (*it)->GetShortName();
+        Add(ranges, sn, sn + 8 * (*it)->GetAttributeCount(), sn, false, *it);
+        offset = count = 0;
+        CGXDLMS::GetActionInfo((*it)->GetObjectType(), offset, count);
+        Add(ranges, sn, sn + offset + 8 * count, sn + offset, true, *it);
+    }
+    m_Ranges.swap(ranges);
+    m_Count = objects.size();
+}
+
+bool CGXSNIndex::IsUpdated(CGXDLMSObjectCollection& objects)
+{
+    return m_Count == objects.size();
+}
+
+bool CGXSNIndex::Find(int sn, CGXSNInfo& info)
+{
+    std::vector<CGXSNRange>::iterator it =
+        std::upper_bound(m_Ranges.begin(), m_Ranges.end(), sn, CGXSNRangeCompare());
+    if (it == m_Ranges.begin())
+    {
+        return false;
+    }
+    --it;
+    if (sn >= it->m_End)
+    {
+        return false;
+    }
+    info.SetItem(it->m_Object);
+    info.SetAction(it->m_Action);
+    info.SetIndex((sn - it->m_Base) / 8 + 1);
+    return true;
+}
+
+void CGXSNIndex::Clear()
+{
+    m_Ranges.clear();
+    m_Count = 0;
+}
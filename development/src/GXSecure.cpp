@@ -64,8 +64,8 @@ int CGXSecure::GenerateChallenge(
 static const unsigned char WRAP_IV[] = { 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6 };
 int CGXSecure::EncryptAesKeyWrapping(CGXByteBuffer& data, CGXByteBuffer& kek, CGXByteBuffer& reply)
 {
-    CGXByteBuffer buf, buf2;
-    //unsigned char buf[16] = { 0 };
+    unsigned char buf[16];
+    unsigned char roundKeys[176];
     unsigned char n, j, i;
 
     if (kek.GetSize() != 16 || data.GetSize() != 16)
@@ -79,26 +79,24 @@ int CGXSecure::EncryptAesKeyWrapping(CGXByteBuffer& data, CGXByteBuffer& kek, CG
     n = (unsigned char)(data.GetSize() >> 3);
     memcpy(reply.GetData(), WRAP_IV, 8);
     memcpy(reply.GetData() + 8, data.GetData(), data.GetSize());
+    //Key is expanded only once.
+    CGXCipher::Aes1ExpandKey(kek.GetData(), roundKeys);
     for (j = 0; j != 6; j++)
     {
         for (i = 1; i <= n; i++)
         {
-            kek.SetPosition(0);
-            buf2.SetSize(0);
-            buf2.Set(&kek);
-            buf.SetSize(0);
-            buf.Set(reply.GetData(), 8);
-            buf.Set(reply.GetData() + (8 * i), 8);
-            CGXCipher::Aes1Encrypt(buf, 0, buf2);
+            memcpy(buf, reply.GetData(), 8);
+            memcpy(buf + 8, reply.GetData() + (8 * i), 8);
+            CGXCipher::Aes1Encrypt(buf, roundKeys);
             unsigned int t = n * j + i;
             for (int k = 1; t != 0; k++)
             {
                 unsigned char v = (unsigned char)t;
-                buf.GetData()[sizeof(WRAP_IV) - k] ^= v;
+                buf[sizeof(WRAP_IV) - k] ^= v;
                 t = (int)((unsigned int)t >> 8);
             }
-            memcpy(reply.GetData(), buf.GetData(), 8);
-            memcpy(reply.GetData() + (8 * i), buf.GetData() + 8, 8);
+            memcpy(reply.GetData(), buf, 8);
+            memcpy(reply.GetData() + (8 * i), buf + 8, 8);
         }
     }
     return 0;
@@ -107,7 +105,8 @@ int CGXSecure::EncryptAesKeyWrapping(CGXByteBuffer& data, CGXByteBuffer& kek, CG
 int CGXSecure::DecryptAesKeyWrapping(CGXByteBuffer& data, CGXByteBuffer& kek, CGXByteBuffer& reply)
 {
     unsigned char a[8];
-    CGXByteBuffer buf, buf2;
+    unsigned char buf[16];
+    unsigned char roundKeys[176];
     signed char j, i;
     unsigned char k, v, n;
     unsigned short t;
@@ -126,25 +125,24 @@ int CGXSecure::DecryptAesKeyWrapping(CGXByteBuffer& data, CGXByteBuffer& kek, CG
     {
         n = 1;
     }
+    //Key is expanded only once.
+    CGXCipher::Aes1ExpandKey(kek.GetData(), roundKeys);
     for (j = 5; j >= 0; j--)
     {
         for (i = n; i >= 1; i--)
         {
-            buf2.SetSize(0);
-            buf2.Set(&kek);
-            buf.SetSize(0);
-            buf.Set(a, sizeof(WRAP_IV));
-            buf.Set(reply.GetData() + 8 * (i - 1), 8);
+            memcpy(buf, a, sizeof(WRAP_IV));
+            memcpy(buf + 8, reply.GetData() + 8 * (i - 1), 8);
             t = n * j + i;
             for (k = 1; t != 0; k++)
             {
                 v = (unsigned char)t;
-                buf.GetData()[sizeof(WRAP_IV) - k] ^= v;
+                buf[sizeof(WRAP_IV) - k] ^= v;
                 t = (unsigned short)(t >> 8);
             }
-            CGXCipher::Aes1Decrypt(buf, buf2);
-            memcpy(a, buf.GetData(), 8);
-            memcpy(reply.GetData() + 8 * (i - 1), buf.GetData() + 8, 8);
+            CGXCipher::Aes1Decrypt(buf, roundKeys);
+            memcpy(a, buf, 8);
+            memcpy(reply.GetData() + 8 * (i - 1), buf + 8, 8);
         }
     }
     if (memcmp(a, WRAP_IV, sizeof(WRAP_IV)) != 0)
@@ -33,6 +33,7 @@
 //---------------------------------------------------------------------------
 
 #include "../include/GXShamirs.h"
+#include "../include/GXFixedCurve.h"
 
 int CGXShamirs::Trick(CGXCurve& curve,
     CGXPublicKey& pub,
@@ -40,61 +41,86 @@ int CGXShamirs::Trick(CGXCurve& curve,
     CGXBigInteger& u1,
     CGXBigInteger& u2)
 {
-    CGXEccPoint sum;
     CGXByteArray x = pub.GetX(), y = pub.GetY();
     CGXBigInteger x1(x);
     CGXBigInteger y1(y);
     CGXEccPoint op2(x1, y1);
-    PointAdd(curve, sum, curve.m_G, op2);
-    uint16_t bits1 = u1.GetUsedBits();
-    uint16_t bits2 = u2.GetUsedBits();
-    uint16_t pos = bits1 > bits2 ? bits1 : bits2;
-    --pos;
-    if (u1.IsBitSet(pos) && u2.IsBitSet(pos))
+    return Trick(curve, op2, ret, u1, u2);
+}
+
+/**
+* Count Shamir's trick with fixed size integers.
+*/
+template <uint16_t BITS>
+static int FixedTrick(CGXCurve& curve,
+    CGXEccPoint& pub,
+    CGXEccPoint& ret,
+    CGXBigInteger& u1,
+    CGXBigInteger& u2)
+{
+    int ret2;
+    CGXFixedCurve<BITS> c;
+    CGXFixedInteger<BITS> x, y, a, b;
+    CGXJacobianPoint<BITS> q;
+    if ((ret2 = c.Init(curve)) != 0 ||
+        (ret2 = x.FromBigInteger(pub.X)) != 0 ||
+        (ret2 = y.FromBigInteger(pub.Y)) != 0 ||
+        (ret2 = a.FromBigInteger(u1)) != 0 ||
+        (ret2 = b.FromBigInteger(u2)) != 0)
     {
-        ret.X = sum.X;
-        ret.Y = sum.Y;
+        return ret2;
     }
-    else if (u1.IsBitSet(pos))
+    c.FromAffine(q, x, y);
+    c.Trick(q, a, b, q);
+    if ((ret2 = c.ToAffine(x, y, q)) == 0)
+    {
+        x.ToBigInteger(ret.X);
+        y.ToBigInteger(ret.Y);
+    }
+    return ret2;
+}
+
+/**
+* Multiply point with fixed size integers in constant time.
+*/
+template <uint16_t BITS>
+static int FixedPointMulti(CGXCurve& curve,
+    CGXEccPoint& ret,
+    CGXEccPoint& point,
+    CGXBigInteger& scalar)
+{
+    int ret2;
+    CGXFixedCurve<BITS> c;
+    CGXFixedInteger<BITS> x, y, k;
+    CGXJacobianPoint<BITS> p;
+    if ((ret2 = c.Init(curve)) != 0 ||
+        (ret2 = x.FromBigInteger(point.X)) != 0 ||
+        (ret2 = y.FromBigInteger(point.Y)) != 0 ||
+        (ret2 = k.FromBigInteger(scalar)) != 0)
     {
-        ret.X = curve.m_G.X;
-        ret.Y = curve.m_G.Y;
+        return ret2;
     }
-    else if (u2.IsBitSet(pos))
+    c.FromAffine(p, x, y);
+    c.Multiply(p, p, k);
+    if ((ret2 = c.ToAffine(x, y, p)) == 0)
     {
-        CGXByteArray tmp = pub.GetX();
-        ret.X = CGXBigInteger(tmp);
-        tmp = pub.GetY();
-        ret.Y = CGXBigInteger(tmp);
+        x.ToBigInteger(ret.X);
+        y.ToBigInteger(ret.Y);
     }
-    CGXEccPoint tmp;
-    --pos;
-    while (true)
+    return ret2;
+}
+
+int CGXShamirs::Trick(CGXCurve& curve,
+    CGXEccPoint& op2,
+    CGXEccPoint& ret,
+    CGXBigInteger& u1,
+    CGXBigInteger& u2)
+{
+    if (curve.m_P.GetUsedBits() <= 256)
     {
-        tmp.X = ret.X;
-        tmp.Y = ret.Y;
-        PointDouble(curve, ret, tmp);
-        tmp.X = ret.X;
-        tmp.Y = ret.Y;
-        if (u1.IsBitSet(pos) && u2.IsBitSet(pos))
-        {
-            PointAdd(curve, ret, tmp, sum);
-        }
-        else if (u1.IsBitSet(pos))
-        {
-            PointAdd(curve, ret, tmp, curve.m_G);
-        }
-        else if (u2.IsBitSet(pos))
-        {
-            PointAdd(curve, ret, tmp, op2);
-        }
-        if (pos == 0)
-        {
-            break;
-        }
-        --pos;
+        return FixedTrick<256>(curve, op2, ret, u1, u2);
     }
-    return 0;
+    return FixedTrick<384>(curve, op2, ret, u1, u2);
 }
 
 int CGXShamirs::PointAdd(CGXCurve& curve,
@@ -162,41 +188,9 @@ int CGXShamirs::PointMulti(CGXCurve& curve,
     CGXEccPoint& point,
     CGXBigInteger& scalar)
 {
-    CGXBigInteger x(point.X);
-    CGXBigInteger y(point.Y);
-    CGXEccPoint R0(x, y);
-    CGXEccPoint R1;
-    CGXEccPoint tmp;
-    PointDouble(curve, R1, point);
-    uint16_t dbits = scalar.GetUsedBits();
-    dbits -= 2;
-    while (true)
+    if (curve.m_P.GetUsedBits() <= 256)
     {
-        if (scalar.IsBitSet(dbits))
-        {
-            tmp.X = R0.X;
-            tmp.Y = R0.Y;
-            PointAdd(curve, R0, R1, tmp);
-            tmp.X = R1.X;
-            tmp.Y = R1.Y;
-            PointDouble(curve, R1, tmp);
-        }
-        else
-        {
-            tmp.X = R1.X;
-            tmp.Y = R1.Y;
-            PointAdd(curve, R1, R0, tmp);
-            tmp.X = R0.X;
-            tmp.Y = R0.Y;
-            PointDouble(curve, R0, tmp);
-        }
-        if (dbits == 0)
-        {
-            break;
-        }
-        --dbits;
+        return FixedPointMulti<256>(curve, ret, point, scalar);
     }
-    ret.X = R0.X;
-    ret.Y = R0.Y;
-    return 0;
-}
\ No newline at end of file
+    return FixedPointMulti<384>(curve, ret, point, scalar);
+}